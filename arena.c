@@ -0,0 +1,135 @@
+#include "arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALINEACION_ARENA 16
+#define REDONDEAR(n) (((n) + ALINEACION_ARENA - 1) & ~(size_t)(ALINEACION_ARENA - 1))
+
+/* Bloque pedido al heap cuando el principal no alcanza. Los datos siguen a la cabecera. */
+typedef struct sBloqueExtra {
+    struct sBloqueExtra *siguiente;
+} tBloqueExtra;
+
+#define CABECERA_EXTRA REDONDEAR(sizeof(tBloqueExtra))
+
+struct sArena {
+    uint8_t *bloque;
+    size_t capacidad;
+    size_t usado;
+    uint8_t *ultima;           /* Última reserva del bloque principal, para agrandarla en el lugar */
+    tBloqueExtra *extras;
+    size_t usadoExtras;        /* Lo que no entró, para dimensionar el bloque al reiniciar */
+};
+
+tArena* arena_crear(size_t capacidad)
+{
+    tArena *a = malloc(sizeof(tArena));
+    if (!a) return NULL;
+    memset(a, 0, sizeof(tArena));
+
+    a->capacidad = REDONDEAR(capacidad ? capacidad : ALINEACION_ARENA);
+    a->bloque = malloc(a->capacidad);
+    if (!a->bloque) {
+        free(a);
+        return NULL;
+    }
+    return a;
+}
+
+void* arena_reservar(tArena *a, size_t bytes)
+{
+    if (!a) return NULL;
+    size_t tam = REDONDEAR(bytes ? bytes : 1);
+
+    if (tam <= a->capacidad - a->usado) {
+        a->ultima = a->bloque + a->usado;
+        a->usado += tam;
+        return a->ultima;
+    }
+
+    tBloqueExtra *extra = malloc(CABECERA_EXTRA + tam);
+    if (!extra) return NULL;
+    extra->siguiente = a->extras;
+    a->extras = extra;
+    a->usadoExtras += tam;
+    return (uint8_t*)extra + CABECERA_EXTRA;
+}
+
+static void _liberar_extras(tArena *a)
+{
+    while (a->extras) {
+        tBloqueExtra *siguiente = a->extras->siguiente;
+        free(a->extras);
+        a->extras = siguiente;
+    }
+}
+
+void arena_reiniciar(tArena *a)
+{
+    if (!a) return;
+
+    if (a->extras) {
+        _liberar_extras(a);
+        /* El contenido ya no importa: se pide el bloque nuevo sin copiar */
+        size_t nuevaCapacidad = a->capacidad + a->usadoExtras;
+        uint8_t *nuevo = malloc(nuevaCapacidad);
+        if (nuevo) {
+            free(a->bloque);
+            a->bloque = nuevo;
+            a->capacidad = nuevaCapacidad;
+        }
+    }
+
+    a->usado = 0;
+    a->usadoExtras = 0;
+    a->ultima = NULL;
+}
+
+size_t arena_usado(const tArena *a)
+{
+    return a ? a->usado + a->usadoExtras : 0;
+}
+
+void arena_destruir(tArena *a)
+{
+    if (!a) return;
+    _liberar_extras(a);
+    free(a->bloque);
+    free(a);
+}
+
+/* ---- Asignador para tVector ---- */
+
+static void* _arena_resize(void *ctx, void *ptr, size_t oldSize, size_t newSize)
+{
+    tArena *a = (tArena*)ctx;
+    if (!ptr) return arena_reservar(a, newSize);
+
+    /* La última reserva crece o se achica en el lugar si el bloque alcanza */
+    if (ptr == a->ultima) {
+        size_t inicio = (size_t)(a->ultima - a->bloque);
+        size_t tam = REDONDEAR(newSize ? newSize : 1);
+        if (tam <= a->capacidad - inicio) {
+            a->usado = inicio + tam;
+            return ptr;
+        }
+    }
+
+    if (newSize <= oldSize) return ptr;
+
+    void *nuevo = arena_reservar(a, newSize);
+    if (nuevo) memcpy(nuevo, ptr, oldSize);
+    return nuevo;
+}
+
+static void _arena_release(void *ctx, void *ptr)
+{
+    (void)ctx; (void)ptr;   /* Se libera todo junto en arena_reiniciar */
+}
+
+tAllocator arena_asignador(tArena *a)
+{
+    tAllocator asignador = { _arena_resize, _arena_release, a };
+    return asignador;
+}
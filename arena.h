@@ -0,0 +1,31 @@
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include "vector.h"
+#include <stddef.h>
+
+/* Estructura opaca: reserva memoria avanzando un puntero sobre un bloque
+   grande. Nada se libera por separado; arena_reiniciar descarta todo junto. */
+typedef struct sArena tArena;
+
+/* Crea una arena con un bloque de 'capacidad' bytes. */
+tArena* arena_crear(size_t capacidad);
+
+/* Reserva 'bytes' alineados para cualquier tipo. Si el bloque se llena,
+   sigue en bloques aparte. Retorna NULL si no hay memoria. */
+void* arena_reservar(tArena *a, size_t bytes);
+
+/* Descarta todo lo reservado. Si hubo desbordes, agranda el bloque para
+   que la próxima vez entre todo en él. */
+void arena_reiniciar(tArena *a);
+
+/* Bytes reservados desde el último reinicio. */
+size_t arena_usado(const tArena *a);
+
+/* Asignador para vector_create_with: los vectores crecen dentro de la arena
+   y vector_destroy no libera nada. */
+tAllocator arena_asignador(tArena *a);
+
+void arena_destruir(tArena *a);
+
+#endif // ARENA_H_INCLUDED
@@ -0,0 +1,97 @@
+#include "benchmark.h"
+#include "rendimiento.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CUADROS_ENTRE_CLICS 4   /* el cursor recorre cartas y cada tanto hace clic */
+
+/* Encola el evento de mouse sobre el centro de una carta al azar. */
+static void _mover_a_carta(tJuego *juego, int clic)
+{
+    int cant = memoria_cantidad_cartas(juego->partida);
+    SDL_Rect rect;
+    if (cant <= 0 || memoria_obtener_rect_carta(juego->partida, rand() % cant, &rect) != 0)
+        return;
+
+    SDL_Event ev;
+    SDL_zero(ev);
+    int x = rect.x + rect.w / 2;
+    int y = rect.y + rect.h / 2;
+
+    if (clic) {
+        ev.type = SDL_MOUSEBUTTONDOWN;
+        ev.button.button = SDL_BUTTON_LEFT;
+        ev.button.state  = SDL_PRESSED;
+        ev.button.clicks = 1;
+        ev.button.x = x;
+        ev.button.y = y;
+    } else {
+        ev.type = SDL_MOUSEMOTION;
+        ev.motion.x = x;
+        ev.motion.y = y;
+    }
+    SDL_PushEvent(&ev);
+}
+
+/* Encola un ENTER para que juego_procesar_eventos reinicie la partida. */
+static void _pedir_reinicio(void)
+{
+    SDL_Event ev;
+    SDL_zero(ev);
+    ev.type = SDL_KEYDOWN;
+    ev.key.state = SDL_PRESSED;
+    ev.key.keysym.sym = SDLK_RETURN;
+    ev.key.keysym.scancode = SDL_SCANCODE_RETURN;
+    SDL_PushEvent(&ev);
+}
+
+static void _imprimir_resumen(tRendimiento *r, SDL_Renderer *renderer, const tOpciones *opciones)
+{
+    SDL_RendererInfo info;
+    const char *driver = SDL_GetRendererInfo(renderer, &info) == 0 ? info.name : "?";
+
+    printf("Benchmark: tablero %dx%d, semilla %u, renderer %s, video %s\n",
+           opciones->filas, opciones->columnas, opciones->semilla,
+           driver, SDL_GetCurrentVideoDriver());
+    printf("%-12s %8s %10s %10s %10s %10s\n", "fase", "muestras", "min ms", "avg ms", "p95 ms", "p99 ms");
+
+    for (int f = 0; f < FASE_CANT; ++f) {
+        tResumenFase res;
+        rendimiento_resumir(r, (tFase)f, &res);
+        printf("%-12s %8u %10.4f %10.4f %10.4f %10.4f\n", rendimiento_nombre_fase((tFase)f),
+               res.muestras, res.minimo, res.promedio, res.p95, res.p99);
+    }
+}
+
+tError benchmark_ejecutar(tJuego *juego, const tOpciones *opciones)
+{
+    /* Las fases internas las mide el propio juego; aquí solo el cuadro completo */
+    tRendimiento *r = juego->rendimiento;
+    rendimiento_limpiar(r);
+
+    for (uint32_t cuadro = 0; cuadro < opciones->cuadros && juego->corriendo; ++cuadro) {
+        if (!juego->partida) break;
+
+        /* Entrada del cuadro: se genera antes de medir, como la de un jugador */
+        if (memoria_partida_terminada(juego->partida))
+            _pedir_reinicio();
+        else
+            _mover_a_carta(juego, cuadro % CUADROS_ENTRE_CLICS == 0);
+
+        rendimiento_iniciar(r, FASE_CUADRO);
+        if (juego_procesar_eventos(juego) == ACCION_SALIR) juego->corriendo = 0;
+        juego_actualizar(juego);
+        juego_renderizar(juego);
+        rendimiento_terminar(r, FASE_CUADRO);
+    }
+
+    _imprimir_resumen(r, juego->renderer, opciones);
+
+    tError err = TODO_OK;
+    if (rendimiento_exportar_csv(r, opciones->rutaCsv) != 0) {
+        fprintf(stderr, "Error: no se pudo escribir %s\n", opciones->rutaCsv);
+        err = ERR_ARCHIVO;
+    }
+
+    return err;
+}
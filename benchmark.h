@@ -0,0 +1,15 @@
+#ifndef BENCHMARK_H_INCLUDED
+#define BENCHMARK_H_INCLUDED
+
+#include "juego.h"
+#include "opciones.h"
+#include "errores.h"
+
+/* Juega 'opciones->cuadros' cuadros con clics sintéticos sobre la partida ya
+   creada por juego_inicializar, acumulando en juego->rendimiento los tiempos
+   de cada fase (eventos, actualizar, cada capa, presentación). Al terminar imprime el resumen y lo
+   escribe en 'opciones->rutaCsv'. Cuando la partida termina se reinicia con
+   la misma configuración, como al presionar ENTER. */
+tError benchmark_ejecutar(tJuego *juego, const tOpciones *opciones);
+
+#endif // BENCHMARK_H_INCLUDED
@@ -0,0 +1,92 @@
+#include "cachedisco.h"
+#include "paquete.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define CREAR_DIRECTORIO(ruta) _mkdir(ruta)
+#else
+#define CREAR_DIRECTORIO(ruta) mkdir((ruta), 0755)
+#endif
+
+#define FNV_BASE  14695981039346656037ULL
+#define FNV_PRIMO 1099511628211ULL
+
+int cache_disco_origen(tOrigenCache *origen, const char *firma, const char *ruta)
+{
+    if (strlen(ruta) >= TAM_RUTA_CACHE) {
+        return 0;
+    }
+
+    memset(origen, 0, sizeof(tOrigenCache));
+    memcpy(origen->firma, firma, TAM_FIRMA_CACHE);
+    strcpy(origen->ruta, ruta);
+
+    // Mismo orden que los cargadores: primero el paquete, despues el archivo suelto
+    if (paquete_ubicar(ruta, &origen->fecha, &origen->desplazamiento, &origen->tamano)) {
+        return 1;
+    }
+
+    struct stat info;
+    if (stat(ruta, &info) != 0) {
+        return 0;
+    }
+    origen->fecha = (int64_t)info.st_mtime;
+    origen->tamano = (uint32_t)info.st_size;
+    return 1;
+}
+
+static uint64_t _fnv(uint64_t hash, const void *datos, size_t bytes)
+{
+    const uint8_t *p = (const uint8_t*)datos;
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIMO;
+    }
+
+    return hash;
+}
+
+void cache_disco_nombre(const void *clave, size_t tamClave, const char *extension,
+                        char *archivo, size_t tamArchivo)
+{
+    // Firma, ruta y los parametros propios de la clave; la version del origen queda afuera
+    const tOrigenCache *origen = (const tOrigenCache*)clave;
+    uint64_t hash = _fnv(FNV_BASE, origen->firma, TAM_FIRMA_CACHE);
+    hash = _fnv(hash, origen->ruta, TAM_RUTA_CACHE);
+    hash = _fnv(hash, (const uint8_t*)clave + sizeof(tOrigenCache), tamClave - sizeof(tOrigenCache));
+
+    snprintf(archivo, tamArchivo, "%s/%016llx.%s", DIR_CACHE_DISCO, (unsigned long long)hash, extension);
+}
+
+int cache_disco_escribir(const char *archivo, const void *cabecera, size_t tamCabecera,
+                         const void *datos, size_t bytesFila, size_t cantFilas, size_t paso)
+{
+    CREAR_DIRECTORIO(DIR_CACHE_DISCO); // Si ya existe falla sin consecuencias
+
+    char temporal[FILENAME_MAX + 4]; // Entra cualquier ruta de la cache mas ".tmp"
+    snprintf(temporal, sizeof(temporal), "%s.tmp", archivo);
+    FILE *salida = fopen(temporal, "wb");
+    if (!salida) {
+        return -1;
+    }
+
+    int ok = fwrite(cabecera, tamCabecera, 1, salida) == 1;
+    for (size_t i = 0; ok && i < cantFilas; i++) {
+        ok = fwrite((const uint8_t*)datos + i * paso, bytesFila, 1, salida) == 1;
+    }
+
+    if (fclose(salida) != 0 || !ok) {
+        remove(temporal);
+        return -1;
+    }
+    remove(archivo); // rename no reemplaza en Windows
+    if (rename(temporal, archivo) != 0) {
+        remove(temporal);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef CACHEDISCO_H_INCLUDED
+#define CACHEDISCO_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Cache en disco de recursos ya decodificados, en el directorio "cache". Cada
+   archivo empieza con una cabecera cuya clave abre con un tOrigenCache; si no
+   coincide con la esperada, el archivo se ignora y se vuelve a escribir. */
+
+#define DIR_CACHE_DISCO "cache"
+#define TAM_FIRMA_CACHE 8
+#define TAM_RUTA_CACHE  128
+
+/* Versión exacta de la que se decodificó un recurso. */
+typedef struct {
+    char firma[TAM_FIRMA_CACHE];   /* Tipo de archivo de la cache */
+    char ruta[TAM_RUTA_CACHE];     /* Ruta de origen, para descartar colisiones del nombre */
+    int64_t fecha;                 /* Modificación del paquete o del archivo suelto */
+    uint32_t desplazamiento;       /* Entrada dentro del paquete; 0 si es un archivo suelto */
+    uint32_t tamano;               /* Bytes de la entrada o del archivo suelto */
+} tOrigenCache;
+
+/* Llena 'origen' con la fuente que usan los cargadores: la entrada del paquete
+   si está ahí, si no el archivo suelto. Retorna 0 si no hay origen o la ruta
+   no entra en la clave. */
+int cache_disco_origen(tOrigenCache *origen, const char *firma, const char *ruta);
+
+/* Nombre del archivo para 'clave', que empieza con su tOrigenCache y ocupa
+   'tamClave' bytes sin basura en el relleno. No depende de la versión del
+   origen: la entrada nueva de un recurso reemplaza a la vieja. */
+void cache_disco_nombre(const void *clave, size_t tamClave, const char *extension,
+                        char *archivo, size_t tamArchivo);
+
+/* Escribe 'cabecera' seguida de 'cantFilas' filas de 'bytesFila' bytes, tomadas
+   cada 'paso' bytes desde 'datos'. Se escribe en un temporal y se renombra: una
+   escritura cortada no deja un archivo a medias. Retorna 0 si OK, -1 si error. */
+int cache_disco_escribir(const char *archivo, const void *cabecera, size_t tamCabecera,
+                         const void *datos, size_t bytesFila, size_t cantFilas, size_t paso);
+
+#endif // CACHEDISCO_H_INCLUDED
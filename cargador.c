@@ -0,0 +1,154 @@
+#include "cargador.h"
+#include "vector.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    tDecodificar decodificar;
+    tDescartar descartar;
+    void *contexto;
+    void *resultado;
+} tTareaCarga;
+
+struct sCargador {
+    tVector *tareas;           /* Vector de tTareaCarga; no cambia una vez iniciado */
+    SDL_Thread *hilo;
+    SDL_atomic_t terminadas;   /* Tareas completas; escrito solo por el hilo */
+    SDL_atomic_t cancelar;
+    SDL_atomic_t finalizado;   /* 1 cuando el hilo ya no va a completar más tareas */
+    SDL_mutex *mutex;          /* Protege la espera de cargador_esperar */
+    SDL_cond *avance;          /* Se señala al terminar cada tarea */
+};
+
+/* Publica un avance del hilo y despierta a quien esté esperando. */
+static void _avisar(tCargador *c, SDL_atomic_t *contador)
+{
+    SDL_LockMutex(c->mutex);
+    SDL_AtomicAdd(contador, 1);
+    SDL_CondBroadcast(c->avance);
+    SDL_UnlockMutex(c->mutex);
+}
+
+/* Cuerpo del hilo: cada resultado queda publicado al incrementar 'terminadas'. */
+static int _hilo_carga(void *datos)
+{
+    tCargador *c = (tCargador*)datos;
+
+    for (size_t i = 0; i < vector_size(c->tareas); ++i) {
+        if (SDL_AtomicGet(&c->cancelar)) break;
+        tTareaCarga *t = (tTareaCarga*)vector_get(c->tareas, i);
+        t->resultado = t->decodificar(t->contexto);
+        _avisar(c, &c->terminadas);
+    }
+
+    _avisar(c, &c->finalizado);
+    return 0;
+}
+
+tCargador* cargador_crear(void)
+{
+    tCargador *c = malloc(sizeof(tCargador));
+    if (!c) return NULL;
+    memset(c, 0, sizeof(tCargador));
+
+    c->tareas = vector_create(sizeof(tTareaCarga));
+    c->mutex = SDL_CreateMutex();
+    c->avance = SDL_CreateCond();
+    if (!c->tareas || !c->mutex || !c->avance) {
+        cargador_destruir(c);
+        return NULL;
+    }
+    SDL_AtomicSet(&c->terminadas, 0);
+    SDL_AtomicSet(&c->cancelar, 0);
+    SDL_AtomicSet(&c->finalizado, 0);
+
+    return c;
+}
+
+int cargador_agregar(tCargador *c, tDecodificar decodificar, tDescartar descartar, void *contexto)
+{
+    if (!c || !decodificar || c->hilo) return -1;
+
+    tTareaCarga t = { decodificar, descartar, contexto, NULL };
+    if (vector_push_back(c->tareas, &t) != 0) return -1;
+
+    return (int)vector_size(c->tareas) - 1;
+}
+
+tError cargador_iniciar(tCargador *c)
+{
+    if (!c) return ERR_MEMORIA;
+    if (c->hilo) return TODO_OK;
+
+    c->hilo = SDL_CreateThread(_hilo_carga, "cargador", c);
+    if (!c->hilo) {
+        fprintf(stderr, "Error: No se pudo crear el hilo de carga: %s\n", SDL_GetError());
+        return ERR_SDL;
+    }
+
+    return TODO_OK;
+}
+
+int cargador_listo(tCargador *c)
+{
+    if (!c || !c->hilo) return 0;
+    return (size_t)SDL_AtomicGet(&c->terminadas) == vector_size(c->tareas);
+}
+
+float cargador_progreso(tCargador *c)
+{
+    if (!c || vector_size(c->tareas) == 0) return 1.0f;
+    return (float)SDL_AtomicGet(&c->terminadas) / (float)vector_size(c->tareas);
+}
+
+int cargador_tarea_lista(tCargador *c, int indice)
+{
+    if (!c || !c->hilo || indice < 0) return 0;
+    return indice < SDL_AtomicGet(&c->terminadas);
+}
+
+void* cargador_retirar(tCargador *c, int indice)
+{
+    if (!cargador_tarea_lista(c, indice)) return NULL;
+
+    tTareaCarga *t = (tTareaCarga*)vector_get(c->tareas, (size_t)indice);
+    if (!t) return NULL;
+
+    void *resultado = t->resultado;
+    t->resultado = NULL;
+    return resultado;
+}
+
+void* cargador_esperar(tCargador *c, int indice)
+{
+    if (!c || !c->hilo || indice < 0 || (size_t)indice >= vector_size(c->tareas)) return NULL;
+
+    SDL_LockMutex(c->mutex);
+    while (!cargador_tarea_lista(c, indice) && !SDL_AtomicGet(&c->finalizado)) {
+        SDL_CondWait(c->avance, c->mutex);
+    }
+    SDL_UnlockMutex(c->mutex);
+
+    return cargador_retirar(c, indice);
+}
+
+void cargador_destruir(tCargador *c)
+{
+    if (!c) return;
+
+    if (c->hilo) {
+        SDL_AtomicSet(&c->cancelar, 1);
+        SDL_WaitThread(c->hilo, NULL);
+    }
+
+    for (size_t i = 0; i < vector_size(c->tareas); ++i) {
+        tTareaCarga *t = (tTareaCarga*)vector_get(c->tareas, i);
+        if (t->resultado && t->descartar) t->descartar(t->resultado);
+    }
+    vector_destroy(c->tareas);
+    if (c->avance) SDL_DestroyCond(c->avance);
+    if (c->mutex) SDL_DestroyMutex(c->mutex);
+    free(c);
+}
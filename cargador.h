@@ -0,0 +1,48 @@
+#ifndef CARGADOR_H_INCLUDED
+#define CARGADOR_H_INCLUDED
+
+#include "errores.h"
+
+/* Estructura opaca: lista de tareas de decodificación que corren en un hilo
+   aparte, para que el hilo principal siga dibujando mientras tanto. */
+typedef struct sCargador tCargador;
+
+/* Decodifica un recurso en el hilo de carga. No puede usar el renderer ni la
+   cache de recursos. Retorna el resultado, o NULL si falló. */
+typedef void* (*tDecodificar)(void *contexto);
+
+/* Libera un resultado que nadie retiró. */
+typedef void (*tDescartar)(void *resultado);
+
+tCargador* cargador_crear(void);
+
+/* Agrega una tarea antes de cargador_iniciar. El contexto debe seguir
+   válido hasta que el cargador termine. Retorna el índice de la tarea,
+   o -1 si no hay memoria. */
+int cargador_agregar(tCargador *c, tDecodificar decodificar, tDescartar descartar, void *contexto);
+
+/* Lanza el hilo de carga, que ejecuta las tareas en orden. */
+tError cargador_iniciar(tCargador *c);
+
+/* Devuelve 1 cuando el hilo ya terminó todas las tareas. */
+int cargador_listo(tCargador *c);
+
+/* Fracción de tareas terminadas, entre 0 y 1. */
+float cargador_progreso(tCargador *c);
+
+/* Devuelve 1 si la tarea 'indice' ya terminó. */
+int cargador_tarea_lista(tCargador *c, int indice);
+
+/* Entrega el resultado de una tarea y deja de ser responsable de liberarlo.
+   Solo es válido con la tarea terminada; retorna NULL en otro caso. */
+void* cargador_retirar(tCargador *c, int indice);
+
+/* Bloquea hasta que la tarea 'indice' termine y entrega su resultado como
+   cargador_retirar. Retorna NULL si la tarea falló o se canceló. */
+void* cargador_esperar(tCargador *c, int indice);
+
+/* Cancela las tareas pendientes, espera al hilo y descarta los resultados
+   que no se retiraron. */
+void cargador_destruir(tCargador *c);
+
+#endif // CARGADOR_H_INCLUDED
@@ -9,6 +9,10 @@ tConfig config_por_defecto(void)
     cfg.columnas = 4;
     cfg.setFiguras = 1;
     cfg.cantJugadores = 1;
+    cfg.bajaLatencia = 0;
+    cfg.bufferAudio = 1024;
+    cfg.bufferVerificado = 0;
+    cfg.canalesAudio = 1;
     return cfg;
 }
 
@@ -27,6 +31,10 @@ tConfig config_cargar(const char *ruta)
             else if (strcmp(clave, "columnas") == 0)   cfg.columnas = valor;
             else if (strcmp(clave, "set") == 0)         cfg.setFiguras = valor;
             else if (strcmp(clave, "jugadores") == 0)   cfg.cantJugadores = valor;
+            else if (strcmp(clave, "baja_latencia") == 0) cfg.bajaLatencia = valor;
+            else if (strcmp(clave, "buffer_audio") == 0)  cfg.bufferAudio = valor;
+            else if (strcmp(clave, "canales_audio") == 0) cfg.canalesAudio = valor;
+            else if (strcmp(clave, "buffer_verificado") == 0) cfg.bufferVerificado = valor;
         }
     }
     fclose(archivo);
@@ -36,6 +44,10 @@ tConfig config_cargar(const char *ruta)
     if (cfg.columnas < 4 || cfg.columnas > 5) cfg.columnas = 4;
     if (cfg.setFiguras < 1 || cfg.setFiguras > 2) cfg.setFiguras = 1;
     if (cfg.cantJugadores < 1 || cfg.cantJugadores > 2) cfg.cantJugadores = 1;
+    if (cfg.bajaLatencia < 0 || cfg.bajaLatencia > 1) cfg.bajaLatencia = 0;
+    if (cfg.bufferAudio < 128 || cfg.bufferAudio > 1024) cfg.bufferAudio = 1024;
+    if (cfg.canalesAudio < 1 || cfg.canalesAudio > 2) cfg.canalesAudio = 1;
+    if (cfg.bufferVerificado != 0 && (cfg.bufferVerificado < 128 || cfg.bufferVerificado > 1024)) cfg.bufferVerificado = 0;
 
     return cfg;
 }
@@ -49,6 +61,10 @@ int config_guardar(const char *ruta, const tConfig *cfg)
     fprintf(archivo, "columnas=%d\n", cfg->columnas);
     fprintf(archivo, "set=%d\n", cfg->setFiguras);
     fprintf(archivo, "jugadores=%d\n", cfg->cantJugadores);
+    fprintf(archivo, "baja_latencia=%d\n", cfg->bajaLatencia);
+    fprintf(archivo, "buffer_audio=%d\n", cfg->bufferAudio);
+    fprintf(archivo, "canales_audio=%d\n", cfg->canalesAudio);
+    fprintf(archivo, "buffer_verificado=%d\n", cfg->bufferVerificado);
 
     fclose(archivo);
     return 0;
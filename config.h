@@ -6,9 +6,14 @@ typedef struct {
     int columnas;        // 4 o 5
     int setFiguras;      // 1 o 2
     int cantJugadores;   // 1 o 2
+    int bajaLatencia;    // 1: buffer de audio chico, se agranda solo si hay cortes (0 por defecto)
+    int bufferAudio;     // muestras por buffer pedidas (128 a 1024)
+    int bufferVerificado; // buffer que pasó la última medición de cortes, 0 si ninguno
+    int canalesAudio;    // 1 mono, 2 estéreo
 } tConfig;
 
-/* Devuelve configuración por defecto (3x4, set 1, 1 jugador). */
+/* Devuelve configuración por defecto (3x4, set 1, 1 jugador, audio mono con buffer de 1024).
+   La baja latencia es opcional: se activa con baja_latencia=1 en el archivo. */
 tConfig config_por_defecto(void);
 
 /* Carga configuración desde archivo. Si no existe, devuelve valores por defecto. */
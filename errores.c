@@ -15,6 +15,8 @@ const char* errores_obtener_detalle(tError err)
         case ERR_IMAGEN:            return "No se pudo cargar la imagen";
         case ERR_HUD_INICIALIZAR:   return "No se pudo inicializar el modulo HUD";
         case ERR_HUD_ACTUALIZAR:    return "No se pudo actualizar una instancia del HUD";
+        case ERR_ARGUMENTOS:        return "Argumentos de linea de comandos invalidos";
+        case ERR_ARCHIVO:           return "No se pudo escribir un archivo";
         default:                    return "Error desconocido";
     }
 }
@@ -26,6 +26,12 @@ typedef enum {
     ERR_HUD_INICIALIZAR,
     ERR_HUD_ACTUALIZAR,
 
+    // Linea de comandos
+    ERR_ARGUMENTOS,
+
+    // Archivos
+    ERR_ARCHIVO,
+
 } tError;
 
 /*
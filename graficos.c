@@ -1,6 +1,18 @@
 #include "graficos.h"
+#include "vector.h"
 #include "stdio.h"
 #include <stdlib.h>
+#include <string.h>
+
+struct sLoteGeometria {
+    tVector *vertices; // Vector de SDL_Vertex
+    tVector *indices;  // Vector de int, seis por cada cuadrilatero
+};
+
+struct sSprite {
+    SDL_Texture *textura; // Streaming, PIXELES_X_LADO x PIXELES_X_LADO
+    uint8_t indices[PIXELES_X_LADO][PIXELES_X_LADO];
+};
 
 SDL_Color colores[] =
 {
@@ -13,23 +25,84 @@ SDL_Color colores[] =
 };
 
 
-void graficos_dibujar(SDL_Renderer *renderer, const uint8_t dibujo[][PIXELES_X_LADO], int32_t oX, int32_t oY)
+#define CANT_COLORES (sizeof(colores) / sizeof(colores[0]))
+
+tSprite* graficos_sprite_compilar(SDL_Renderer *renderer, const uint8_t matriz[][PIXELES_X_LADO], const SDL_Color *paleta, uint32_t cantColores)
+{
+    tSprite *sprite = malloc(sizeof(tSprite));
+    if (!sprite) {
+        return NULL;
+    }
+
+    memcpy(sprite->indices, matriz, sizeof(sprite->indices));
+    sprite->textura = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, PIXELES_X_LADO, PIXELES_X_LADO);
+    if (!sprite->textura) {
+        fprintf(stderr, "Error: No se pudo crear la textura del sprite: %s\n", SDL_GetError());
+        free(sprite);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(sprite->textura, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(sprite->textura, SDL_ScaleModeNearest); // Pixeles nitidos al escalar
+
+    if (graficos_sprite_paleta(sprite, paleta, cantColores) != 0) {
+        graficos_sprite_destruir(sprite);
+        return NULL;
+    }
+
+    return sprite;
+}
+
+int32_t graficos_sprite_paleta(tSprite *sprite, const SDL_Color *paleta, uint32_t cantColores)
 {
-    int32_t offsetX = oX * (PIXELES_X_LADO * TAM_PIXEL + PX_PADDING);
-    int32_t offsetY = oY * (PIXELES_X_LADO * TAM_PIXEL + PX_PADDING);
-    uint8_t transparencia = rand() & 255;
+    if (!paleta) {
+        paleta = colores;
+        cantColores = CANT_COLORES;
+    }
+
+    void *pixeles;
+    int pitch;
+    if (SDL_LockTexture(sprite->textura, NULL, &pixeles, &pitch) != 0) {
+        fprintf(stderr, "Error: No se pudo bloquear la textura del sprite: %s\n", SDL_GetError());
+        return -1;
+    }
 
     for (int32_t y = 0; y < PIXELES_X_LADO; y++) {
+        Uint32 *fila = (Uint32*)((Uint8*)pixeles + y * pitch);
         for (int32_t x = 0; x < PIXELES_X_LADO; x++) {
-            SDL_SetRenderDrawColor(renderer,
-                                   colores[dibujo[y][x]].r,
-                                   colores[dibujo[y][x]].g,
-                                   colores[dibujo[y][x]].b,
-                                   colores[dibujo[y][x]].a == 0 ? 0 : transparencia);
-            SDL_Rect pixel = {offsetX + TAM_PIXEL*x, offsetY + TAM_PIXEL*y, TAM_PIXEL, TAM_PIXEL};
-            SDL_RenderFillRect(renderer, &pixel);
+            uint8_t indice = sprite->indices[y][x];
+            SDL_Color c = indice < cantColores ? paleta[indice] : (SDL_Color){0, 0, 0, 0};
+            fila[x] = ((Uint32)c.r << 24) | ((Uint32)c.g << 16) | ((Uint32)c.b << 8) | c.a;
         }
     }
+
+    SDL_UnlockTexture(sprite->textura);
+    return 0;
+}
+
+void graficos_dibujar(SDL_Renderer *renderer, const tSprite *sprite, int32_t oX, int32_t oY, SDL_Color tinte)
+{
+    SDL_Rect destino = {
+        oX * (PIXELES_X_LADO * TAM_PIXEL + PX_PADDING),
+        oY * (PIXELES_X_LADO * TAM_PIXEL + PX_PADDING),
+        PIXELES_X_LADO * TAM_PIXEL,
+        PIXELES_X_LADO * TAM_PIXEL
+    };
+
+    SDL_SetTextureColorMod(sprite->textura, tinte.r, tinte.g, tinte.b);
+    SDL_SetTextureAlphaMod(sprite->textura, tinte.a);
+    SDL_RenderCopy(renderer, sprite->textura, NULL, &destino);
+}
+
+void graficos_sprite_destruir(tSprite *sprite)
+{
+    if (!sprite) {
+        return;
+    }
+
+    if (sprite->textura) {
+        SDL_DestroyTexture(sprite->textura);
+    }
+    free(sprite);
 }
 
 void graficos_dibujar_textura(SDL_Renderer *renderer, SDL_Texture *textura, SDL_Rect *origen, int32_t posX, int32_t posY, float escalaHor, float escalaVer, double angulo, uint8_t flipHor, uint8_t flipVer)
@@ -74,12 +147,39 @@ SDL_Texture* graficos_crear_framebuffer(SDL_Renderer *renderer, uint32_t anchoVe
     return framebuffer;
 }
 
+static SDL_BlendMode _modo_premultiplicado(void)
+{
+    return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+}
+
+SDL_Texture* graficos_crear_lienzo(SDL_Renderer *renderer, uint32_t ancho, uint32_t alto)
+{
+    SDL_Texture *lienzo = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, ancho, alto);
+    if (!lienzo) {
+        fprintf(stderr, "Error: No se pudo crear el lienzo: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    if (SDL_SetTextureBlendMode(lienzo, _modo_premultiplicado()) != 0) {
+        SDL_SetTextureBlendMode(lienzo, SDL_BLENDMODE_BLEND); // Ej: renderizador por software
+    }
+
+    return lienzo;
+}
+
+int graficos_lienzo_premultiplicado(SDL_Texture *lienzo)
+{
+    SDL_BlendMode modo;
+    return lienzo && SDL_GetTextureBlendMode(lienzo, &modo) == 0 && modo == _modo_premultiplicado();
+}
+
 void graficos_cambiar_framebuffer(SDL_Renderer *renderer, SDL_Texture *target)
 {
     SDL_SetRenderTarget(renderer, target);
 }
 
-void graficos_renderizar(SDL_Renderer *renderer, SDL_Texture* const *framebuffers, uint32_t cantFramebuffers)
+void graficos_componer(SDL_Renderer *renderer, SDL_Texture* const *framebuffers, uint32_t cantFramebuffers)
 {
     SDL_SetRenderTarget(renderer, NULL);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
@@ -90,6 +190,111 @@ void graficos_renderizar(SDL_Renderer *renderer, SDL_Texture* const *framebuffer
             SDL_RenderCopy(renderer, framebuffers[i], NULL, NULL);
         }
     }
+}
 
+void graficos_renderizar(SDL_Renderer *renderer, SDL_Texture* const *framebuffers, uint32_t cantFramebuffers)
+{
+    graficos_componer(renderer, framebuffers, cantFramebuffers);
     SDL_RenderPresent(renderer);
 }
+
+int32_t graficos_grilla_indice(const tGrilla *grilla, int32_t x, int32_t y)
+{
+    int32_t dx = x - grilla->origenX;
+    int32_t dy = y - grilla->origenY;
+    if (dx < 0 || dy < 0 || grilla->pasoX <= 0 || grilla->pasoY <= 0) {
+        return -1;
+    }
+
+    int32_t columna = dx / grilla->pasoX;
+    int32_t fila = dy / grilla->pasoY;
+    if (columna >= grilla->columnas || fila >= grilla->filas) {
+        return -1;
+    }
+
+    if (dx - columna * grilla->pasoX > grilla->anchoCelda ||
+        dy - fila * grilla->pasoY > grilla->altoCelda) {
+        return -1; // Espacio entre celdas
+    }
+
+    return fila * grilla->columnas + columna;
+}
+
+tLoteGeometria* graficos_lote_crear(void)
+{
+    tLoteGeometria *lote = malloc(sizeof(tLoteGeometria));
+    if (!lote) {
+        return NULL;
+    }
+
+    lote->vertices = vector_create(sizeof(SDL_Vertex));
+    lote->indices = vector_create(sizeof(int));
+    if (!lote->vertices || !lote->indices) {
+        graficos_lote_destruir(lote);
+        return NULL;
+    }
+
+    return lote;
+}
+
+static void _lote_agregar_quad(tLoteGeometria *lote, float x, float y, float w, float h, SDL_Color color)
+{
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    int base = (int)vector_size(lote->vertices);
+    SDL_Vertex esquinas[4] = {
+        { {x,     y    }, color, {0, 0} },
+        { {x + w, y    }, color, {0, 0} },
+        { {x + w, y + h}, color, {0, 0} },
+        { {x,     y + h}, color, {0, 0} },
+    };
+    int triangulos[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+
+    vector_push_range(lote->vertices, esquinas, 4);
+    vector_push_range(lote->indices, triangulos, 6);
+}
+
+void graficos_lote_rect(tLoteGeometria *lote, const SDL_Rect *rect, SDL_Color color)
+{
+    _lote_agregar_quad(lote, rect->x, rect->y, rect->w, rect->h, color);
+}
+
+void graficos_lote_borde(tLoteGeometria *lote, const SDL_Rect *rect, int32_t grosor, SDL_Color color)
+{
+    if (grosor * 2 >= rect->w || grosor * 2 >= rect->h) {
+        graficos_lote_rect(lote, rect, color); // El borde cubre todo el rectangulo
+        return;
+    }
+
+    int32_t altoLateral = rect->h - grosor * 2;
+    _lote_agregar_quad(lote, rect->x, rect->y, rect->w, grosor, color);                                // Superior
+    _lote_agregar_quad(lote, rect->x, rect->y + rect->h - grosor, rect->w, grosor, color);             // Inferior
+    _lote_agregar_quad(lote, rect->x, rect->y + grosor, grosor, altoLateral, color);                   // Izquierdo
+    _lote_agregar_quad(lote, rect->x + rect->w - grosor, rect->y + grosor, grosor, altoLateral, color); // Derecho
+}
+
+void graficos_lote_enviar(SDL_Renderer *renderer, tLoteGeometria *lote)
+{
+    if (vector_size(lote->indices) > 0) {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); // Sin textura se usa el modo de dibujo del renderer
+        SDL_RenderGeometry(renderer, NULL,
+                           (const SDL_Vertex*)lote->vertices->data, (int)vector_size(lote->vertices),
+                           (const int*)lote->indices->data, (int)vector_size(lote->indices));
+    }
+
+    vector_clear(lote->vertices);
+    vector_clear(lote->indices);
+}
+
+void graficos_lote_destruir(tLoteGeometria *lote)
+{
+    if (!lote) {
+        return;
+    }
+
+    vector_destroy(lote->vertices);
+    vector_destroy(lote->indices);
+    free(lote);
+}
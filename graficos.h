@@ -15,14 +15,83 @@
 #define T 5 // Transparente
 
 /**
- * @brief Dibuja un sprite a partir de una matriz de indices de colores.
+ * @brief Estructura opaca que acumula geometria coloreada para enviarla en una sola llamada.
+ * * * Los rectangulos rellenos y los bordes se traducen a triangulos dentro de un unico
+ * buffer de vertices, que se envia al renderizador con 'SDL_RenderGeometry'. El orden
+ * de dibujado dentro del lote se respeta.
+ */
+typedef struct sLoteGeometria tLoteGeometria;
+
+/**
+ * @brief Grilla regular de celdas del mismo tamano, separadas por un paso constante.
+ * * * Permite resolver que celda contiene un punto con aritmetica, sin recorrer las
+ * celdas, sin importar cuantas sean. Los espacios entre celdas no pertenecen a ninguna.
+ */
+typedef struct {
+    int32_t origenX;    // Esquina superior izquierda de la primera celda
+    int32_t origenY;
+    int32_t anchoCelda;
+    int32_t altoCelda;
+    int32_t pasoX;      // Distancia entre el inicio de dos columnas consecutivas
+    int32_t pasoY;      // Distancia entre el inicio de dos filas consecutivas
+    int32_t columnas;
+    int32_t filas;
+} tGrilla;
+
+/**
+ * @brief Estructura opaca de un sprite de pixel art compilado en una textura.
+ * * * La matriz de indices se traduce una sola vez a una textura de tipo 'streaming'
+ * de PIXELES_X_LADO x PIXELES_X_LADO pixeles, que luego se escala al dibujarse.
+ * El sprite conserva sus indices, por lo que cambiar de paleta solo reescribe
+ * la textura, sin volver a crearla.
+ */
+typedef struct sSprite tSprite;
+
+/**
+ * @brief Compila una matriz de indices de colores en un sprite.
  *
  * @param renderer Puntero al renderizador de SDL.
  * @param matriz Matriz del sprite que contiene los indices de la paleta de colores.
- * @param oX Coordenada X en pantalla.
- * @param oY Coordenada Y en pantalla.
+ * @param paleta Paleta de colores a utilizar, o NULL para la paleta por defecto (N, A, B, V, R, T).
+ * @param cantColores Cantidad de colores de la paleta (ignorado si 'paleta' es NULL).
+ *
+ * @return tSprite* Puntero al sprite creado, o NULL en caso de error.
+ *
+ * @note Los indices fuera de la paleta se dibujan transparentes. El sprite debe ser
+ * liberado con la funcion 'graficos_sprite_destruir' al finalizar su uso.
+ */
+tSprite* graficos_sprite_compilar(SDL_Renderer *renderer, const uint8_t matriz[][PIXELES_X_LADO], const SDL_Color *paleta, uint32_t cantColores);
+
+/**
+ * @brief Reescribe los pixeles del sprite con otra paleta.
+ *
+ * @param sprite Puntero al sprite.
+ * @param paleta Nueva paleta de colores, o NULL para la paleta por defecto.
+ * @param cantColores Cantidad de colores de la paleta (ignorado si 'paleta' es NULL).
+ *
+ * @return int32_t 0 si se actualizo la textura, o -1 en caso de error.
+ */
+int32_t graficos_sprite_paleta(tSprite *sprite, const SDL_Color *paleta, uint32_t cantColores);
+
+/**
+ * @brief Dibuja un sprite compilado con una sola copia de textura.
+ * * * El tinte y la transparencia se aplican mediante los modificadores de color
+ * y alfa de la textura, sin tocar sus pixeles.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param sprite Puntero constante al sprite a dibujar.
+ * @param oX Columna de la grilla de sprites (de a TAM_PIXEL * PIXELES_X_LADO + PX_PADDING pixeles).
+ * @param oY Fila de la grilla de sprites.
+ * @param tinte Color que multiplica al sprite; su canal alfa define la transparencia.
  */
-void graficos_dibujar(SDL_Renderer *renderer, const uint8_t[][PIXELES_X_LADO], int32_t oX, int32_t oY);
+void graficos_dibujar(SDL_Renderer *renderer, const tSprite *sprite, int32_t oX, int32_t oY, SDL_Color tinte);
+
+/**
+ * @brief Libera los recursos del sprite.
+ *
+ * @param sprite Puntero al sprite a destruir.
+ */
+void graficos_sprite_destruir(tSprite *sprite);
 
 /**
  * @brief Renderizado avanzado de texturas con soporte para transformaciones.
@@ -63,6 +132,35 @@ void graficos_borrar_pantalla(SDL_Renderer *renderer, const SDL_Color *color);
  */
 SDL_Texture* graficos_crear_framebuffer(SDL_Renderer *renderer, uint32_t anchoVentana, uint32_t altoVentana);
 
+/**
+ * @brief Crea una textura target para pre-renderizar un elemento y reutilizarlo.
+ * * * Dibujar con mezcla alfa sobre una textura transparente deja su contenido con el
+ * alfa premultiplicado. Por eso la textura se configura para componerse con un modo
+ * de mezcla premultiplicado, de modo que copiarla produzca el mismo resultado que
+ * dibujar su contenido directamente sobre el destino.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param ancho Ancho en pixeles de la textura a crear.
+ * @param alto Alto en pixeles de la textura a crear.
+ *
+ * @return SDL_Texture* Puntero a la textura creada o NULL en caso de error.
+ *
+ * @note Si el renderizador no soporta modos de mezcla personalizados se usa
+ * 'SDL_BLENDMODE_BLEND'. La textura debe ser liberada con 'SDL_DestroyTexture'.
+ */
+SDL_Texture* graficos_crear_lienzo(SDL_Renderer *renderer, uint32_t ancho, uint32_t alto);
+
+/**
+ * @brief Indica si un lienzo quedo con el modo de mezcla premultiplicado.
+ * * * Si no, copiar contenido semitransparente dibujado en el aplica el alfa dos
+ * veces; conviene dibujar ese contenido directamente sobre el destino.
+ *
+ * @param lienzo Textura creada con 'graficos_crear_lienzo'.
+ *
+ * @return int 1 si el lienzo usa el modo premultiplicado, 0 si no.
+ */
+int graficos_lienzo_premultiplicado(SDL_Texture *lienzo);
+
 /**
  * @brief Cambia el framebuffer objetivo de renderizado.
  *
@@ -71,6 +169,17 @@ SDL_Texture* graficos_crear_framebuffer(SDL_Renderer *renderer, uint32_t anchoVe
  */
 void graficos_cambiar_framebuffer(SDL_Renderer *renderer, SDL_Texture *target);
 
+/**
+ * @brief Compone multiples framebuffers en la pantalla sin presentarlos.
+ * * * Igual que 'graficos_renderizar', pero sin llamar a 'SDL_RenderPresent', para
+ * poder dibujar encima de la composicion (o medir la presentacion por separado).
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param framebuffers Puntero a un array de punteros a texturas.
+ * @param cantFramebuffers Cantidad total de capas a procesar.
+ */
+void graficos_componer(SDL_Renderer *renderer, SDL_Texture* const *framebuffers, uint32_t cantFramebuffers);
+
 /**
  * @brief Renderiza multiples framebuffers segun su orden de aparicion.
  * * * Esta funcion realiza la composicion de un array de texturas respetando el orden
@@ -83,5 +192,64 @@ void graficos_cambiar_framebuffer(SDL_Renderer *renderer, SDL_Texture *target);
  */
 void graficos_renderizar(SDL_Renderer *renderer, SDL_Texture* const *framebuffers, uint32_t cantFramebuffers);
 
+/**
+ * @brief Devuelve el indice de la celda que contiene un punto.
+ * * * Los bordes derecho e inferior de cada celda se consideran dentro de ella.
+ *
+ * @param grilla Puntero constante a la grilla.
+ * @param x Coordenada X del punto.
+ * @param y Coordenada Y del punto.
+ *
+ * @return int32_t Indice de la celda (fila * columnas + columna), o -1 si el punto cae
+ * fuera de la grilla o en el espacio entre celdas.
+ */
+int32_t graficos_grilla_indice(const tGrilla *grilla, int32_t x, int32_t y);
+
+/**
+ * @brief Crea un lote de geometria vacio.
+ *
+ * @return tLoteGeometria* Puntero al lote creado, o NULL en caso de error.
+ *
+ * @note El lote debe ser liberado con la funcion 'graficos_lote_destruir' al finalizar su uso.
+ */
+tLoteGeometria* graficos_lote_crear(void);
+
+/**
+ * @brief Agrega un rectangulo relleno al lote.
+ *
+ * @param lote Puntero al lote.
+ * @param rect Puntero constante al rectangulo a rellenar.
+ * @param color Color del relleno (se respeta el canal alfa).
+ */
+void graficos_lote_rect(tLoteGeometria *lote, const SDL_Rect *rect, SDL_Color color);
+
+/**
+ * @brief Agrega el borde interior de un rectangulo al lote.
+ * * * Equivale a dibujar 'grosor' rectangulos concentricos con 'SDL_RenderDrawRect',
+ * pero usando cuatro cuadrilateros que no se superponen.
+ *
+ * @param lote Puntero al lote.
+ * @param rect Puntero constante al rectangulo exterior.
+ * @param grosor Ancho del borde en pixeles.
+ * @param color Color del borde (se respeta el canal alfa).
+ */
+void graficos_lote_borde(tLoteGeometria *lote, const SDL_Rect *rect, int32_t grosor, SDL_Color color);
+
+/**
+ * @brief Envia el contenido del lote al renderizador y lo vacia.
+ * * * Se dibuja con mezcla alfa ('SDL_BLENDMODE_BLEND') sobre el framebuffer actual.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param lote Puntero al lote.
+ */
+void graficos_lote_enviar(SDL_Renderer *renderer, tLoteGeometria *lote);
+
+/**
+ * @brief Libera los recursos del lote.
+ *
+ * @param lote Puntero al lote a destruir.
+ */
+void graficos_lote_destruir(tLoteGeometria *lote);
+
 
 #endif // GRAFICOS_H_INCLUDED
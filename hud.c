@@ -34,12 +34,12 @@ tHUD* hud_inicializar (SDL_Renderer *renderer, int32_t posX, int32_t posY, void
         hud->dato = NULL;
     }
 
-    memcpy(hud->dato, dato, tamDato);
     hud->tamDato = tamDato;
     hud->extra = extra;
 
     hud->posX = posX;
     hud->posY = posY;
+    hud->angulo = 0;
 
     hud->actualizar = actualizar;
     hud->destruir = destruir;
@@ -95,20 +95,41 @@ tError hud_actualizar_dato (tHUD *hud, void *datoNuevo)
         return ERR_HUD_ACTUALIZAR;
     }
 
+    // Mismo dato que el de la textura actual: no hace falta regenerarla
+    if (hud->textura && hud->dato && datoNuevo && memcmp(hud->dato, datoNuevo, hud->tamDato) == 0) {
+        return TODO_OK;
+    }
+
     SDL_Texture *nuevaTextura = hud->actualizar(hud->renderer, hud->dato, datoNuevo, hud->extra);
     if (!nuevaTextura) {
         return ERR_TEXTURA;
     }
 
-    if (hud->textura) {
+    if (hud->textura && hud->textura != nuevaTextura) {
         SDL_DestroyTexture(hud->textura);
     }
 
     hud->textura = nuevaTextura;
 
+    if (hud->dato && datoNuevo) {
+        memcpy(hud->dato, datoNuevo, hud->tamDato);
+    }
+
     return TODO_OK;
 }
 
+void hud_obtener_tamano (const tHUD *hud, int32_t *ancho, int32_t *alto)
+{
+    int32_t w = 0, h = 0;
+
+    if (hud->textura) {
+        SDL_QueryTexture(hud->textura, NULL, NULL, &w, &h);
+    }
+
+    if (ancho) *ancho = w;
+    if (alto)  *alto = h;
+}
+
 void hud_destruir (tHUD *hud)
 {
     if (hud->destruir != NULL) {
@@ -31,7 +31,8 @@ typedef struct sHUD tHUD;
  * @param datoNuevo Puntero con el dato actualizado que el usuario necesite.
  * @param extra Puntero a recursos externos necesarios para la actualizacion.
  *
- * @return SDL_Texture* La nueva textura generada para la instancia.
+ * @return SDL_Texture* La nueva textura generada para la instancia. Puede ser la misma
+ * textura que ya tenia el HUD (redibujada en el lugar), en cuyo caso no se destruye.
  */
 typedef SDL_Texture* (*tActualizarHUD) (SDL_Renderer *renderer, void *dato, void *datoNuevo, void *extra);
 
@@ -76,15 +77,33 @@ void hud_dibujar (const tHUD *hud);
 
 /**
  * @brief Actualiza el contenido del HUD.
- * * * Ejecuta el callback 'actualizar' y reemplaza la textura anterior por la nueva.
+ * * * Si el HUD almacena un dato y 'datoNuevo' es igual byte a byte al dato almacenado
+ * (comparado con 'memcmp'), la textura actual sigue siendo valida y no se regenera.
+ * En otro caso ejecuta el callback 'actualizar', reemplaza la textura anterior por la
+ * nueva y guarda una copia de 'datoNuevo'.
  *
  * @param hud Puntero a la instancia del HUD.
  * @param datoNuevo Puntero al nuevo dato a visualizar.
  *
  * @return tError TODO_OK si se actualizo correctamente, o un codigo de error.
+ *
+ * @note Como la comparacion es byte a byte, las estructuras usadas como dato deben
+ * inicializarse por completo (por ejemplo con 'memset') para que el relleno no
+ * provoque regeneraciones innecesarias.
  */
 tError hud_actualizar_dato (tHUD *hud, void *datoNuevo);
 
+/**
+ * @brief Obtiene el tamano de la textura actual del HUD.
+ *
+ * @param hud Puntero constante a la instancia del HUD.
+ * @param ancho Puntero donde se guarda el ancho en pixeles, o NULL.
+ * @param alto Puntero donde se guarda el alto en pixeles, o NULL.
+ *
+ * @note Si el HUD todavia no tiene textura, ambos valores son 0.
+ */
+void hud_obtener_tamano (const tHUD *hud, int32_t *ancho, int32_t *alto);
+
 /**
  * @brief Define la nueva posicion y angulo del HUD de forma absoluta.
  *
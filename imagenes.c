@@ -1,5 +1,28 @@
 #include "imagenes.h"
+#include "paquete.h"
+#include "cachedisco.h"
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SEPARACION_ATLAS 1 // Pixeles libres entre regiones para que el filtrado no mezcle imagenes vecinas
+#define FIRMA_CACHE_IMAGEN "MEMOTEX1"
+
+// Identifica una imagen decodificada dentro de la cache
+typedef struct {
+    tOrigenCache origen;        // Archivo del que se decodifico
+    uint32_t formato;           // SDL_PixelFormatEnum de los pixeles (de 32 bits)
+    int32_t anchoPedido;        // 0x0 para el tamano original
+    int32_t altoPedido;
+} tClaveCacheImg;
+
+// Cabecera de un archivo de la cache, seguida por las filas de pixeles sin relleno.
+// Es un archivo local: se escribe en el orden de bytes del equipo.
+typedef struct {
+    tClaveCacheImg clave;
+    int32_t ancho;              // Tamano de los pixeles guardados
+    int32_t alto;
+} tCabeceraCacheImg;
 
 tFormatosImg imagenes_inicializar(void)
 {
@@ -27,11 +50,157 @@ tFormatosImg imagenes_inicializar(void)
 }
 
 
+/* ---- Cache de imagenes decodificadas ---- */
+
+// Arma la cabecera esperada y el nombre del archivo. Retorna 0 si la imagen no se puede cachear.
+static int _clave_cache(const char *path, int32_t ancho, int32_t alto, uint32_t formato,
+                        tClaveCacheImg *clave, char *archivo, size_t tamArchivo)
+{
+    memset(clave, 0, sizeof(tClaveCacheImg)); // La clave entera se compara con memcmp
+    if (!cache_disco_origen(&clave->origen, FIRMA_CACHE_IMAGEN, path)) {
+        return 0;
+    }
+    clave->formato = formato;
+    clave->anchoPedido = ancho;
+    clave->altoPedido = alto;
+
+    cache_disco_nombre(clave, sizeof(tClaveCacheImg), "img", archivo, tamArchivo);
+    return 1;
+}
+
+static SDL_Surface* _leer_cache(const char *archivo, const tClaveCacheImg *clave)
+{
+    SDL_RWops *rw = SDL_RWFromFile(archivo, "rb");
+    if (!rw) {
+        return NULL;
+    }
+
+    tCabeceraCacheImg cabecera;
+    SDL_Surface *superficie = NULL;
+    if (SDL_RWread(rw, &cabecera, sizeof(cabecera), 1) == 1 &&
+        memcmp(&cabecera.clave, clave, sizeof(tClaveCacheImg)) == 0 &&
+        cabecera.ancho > 0 && cabecera.alto > 0) {
+        superficie = SDL_CreateRGBSurfaceWithFormat(0, cabecera.ancho, cabecera.alto, 32, clave->formato);
+    }
+
+    // Los pixeles se leen directo sobre la superficie, sin decodificar nada
+    size_t bytesFila = superficie ? (size_t)superficie->w * 4 : 0;
+    for (int32_t y = 0; superficie && y < superficie->h; y++) {
+        if (SDL_RWread(rw, (uint8_t*)superficie->pixels + (size_t)y * superficie->pitch, bytesFila, 1) != 1) {
+            SDL_FreeSurface(superficie);
+            superficie = NULL;
+        }
+    }
+
+    SDL_RWclose(rw);
+    return superficie;
+}
+
+static void _escribir_cache(const char *archivo, const tClaveCacheImg *clave, SDL_Surface *superficie)
+{
+    tCabeceraCacheImg cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    cabecera.clave = *clave;
+    cabecera.ancho = superficie->w;
+    cabecera.alto = superficie->h;
+
+    // Las filas se guardan sin el relleno del pitch
+    cache_disco_escribir(archivo, &cabecera, sizeof(cabecera), superficie->pixels,
+                         (size_t)superficie->w * 4, (size_t)superficie->h, (size_t)superficie->pitch);
+}
+
+/* Devuelve la imagen en 'formato' (de 32 bits) y escalada a ancho x alto (0x0: tamano original).
+   Usa la cache si el origen no cambio; si no, decodifica y guarda el resultado. */
+static SDL_Surface* _cargar_superficie(const char *path, int32_t ancho, int32_t alto, uint32_t formato)
+{
+    tClaveCacheImg clave;
+    char archivo[FILENAME_MAX];
+    int cacheable = _clave_cache(path, ancho, alto, formato, &clave, archivo, sizeof(archivo));
+
+    if (cacheable) {
+        SDL_Surface *cacheada = _leer_cache(archivo, &clave);
+        if (cacheada) {
+            return cacheada;
+        }
+    }
+
+    // Si hay paquete de recursos se lee de la memoria mapeada
+    SDL_RWops *rw = paquete_leer(path);
+    SDL_Surface *original = rw ? IMG_Load_RW(rw, 1) : IMG_Load(path);
+    if (!original) {
+        return NULL;
+    }
+
+    SDL_Surface *superficie = SDL_ConvertSurfaceFormat(original, formato, 0);
+    SDL_FreeSurface(original);
+    if (!superficie) {
+        return NULL;
+    }
+
+    if (ancho > 0 && alto > 0 && (superficie->w != ancho || superficie->h != alto)) {
+        SDL_Surface *escalada = SDL_CreateRGBSurfaceWithFormat(0, ancho, alto, 32, formato);
+        if (escalada && SDL_SoftStretchLinear(superficie, NULL, escalada, NULL) == 0) {
+            SDL_FreeSurface(superficie);
+            superficie = escalada;
+        } else {
+            // Se usa sin escalar; el renderer la estira al dibujarla
+            if (escalada) SDL_FreeSurface(escalada);
+            cacheable = 0;
+        }
+    }
+
+    if (cacheable) {
+        _escribir_cache(archivo, &clave, superficie);
+    }
+
+    return superficie;
+}
+
+// Primer formato de 32 bits que el renderer acepta sin convertir
+static uint32_t _formato_nativo(SDL_Renderer *renderer)
+{
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        for (uint32_t i = 0; i < info.num_texture_formats; i++) {
+            uint32_t formato = info.texture_formats[i];
+            if (!SDL_ISPIXELFORMAT_FOURCC(formato) && SDL_BYTESPERPIXEL(formato) == 4) {
+                return formato;
+            }
+        }
+    }
+
+    return SDL_PIXELFORMAT_ARGB8888;
+}
+
 SDL_Texture* imagenes_cargar_gpu(SDL_Renderer *renderer, const char *path)
 {
-    SDL_Texture *textura = IMG_LoadTexture(renderer, path);
-    if (!textura) {
+    return imagenes_cargar_gpu_escalada(renderer, path, 0, 0);
+}
+
+SDL_Texture* imagenes_cargar_gpu_escalada(SDL_Renderer *renderer, const char *path, int32_t ancho, int32_t alto)
+{
+    uint32_t formato = _formato_nativo(renderer);
+    SDL_Surface *superficie = _cargar_superficie(path, ancho, alto, formato);
+    if (!superficie) {
         fprintf(stderr, "Fallo la carga de la imagen \"%s:\" %s\n", path, IMG_GetError());
+        return NULL;
+    }
+
+    // Los pixeles ya estan en el formato del renderer: se suben sin conversion
+    SDL_Texture *textura = SDL_CreateTexture(renderer, formato, SDL_TEXTUREACCESS_STATIC, superficie->w, superficie->h);
+    if (textura && SDL_UpdateTexture(textura, NULL, superficie->pixels, superficie->pitch) != 0) {
+        SDL_DestroyTexture(textura);
+        textura = NULL;
+    }
+    SDL_FreeSurface(superficie);
+
+    if (!textura) {
+        fprintf(stderr, "Fallo la carga de la imagen \"%s:\" %s\n", path, SDL_GetError());
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_ALPHA(formato)) {
+        SDL_SetTextureBlendMode(textura, SDL_BLENDMODE_BLEND);
     }
 
     return textura;
@@ -39,7 +208,7 @@ SDL_Texture* imagenes_cargar_gpu(SDL_Renderer *renderer, const char *path)
 
 SDL_Surface* imagenes_cargar_ram(const char *path)
 {
-    SDL_Surface *superficie = IMG_Load(path);
+    SDL_Surface *superficie = _cargar_superficie(path, 0, 0, SDL_PIXELFORMAT_RGBA32);
     if (!superficie) {
         fprintf(stderr, "Fallo la carga de la imagen en RAM \"%s:\" %s\n", path, IMG_GetError());
     }
@@ -47,6 +216,129 @@ SDL_Surface* imagenes_cargar_ram(const char *path)
     return superficie;
 }
 
+SDL_Surface* imagenes_empaquetar_atlas(SDL_Surface *const *superficies, size_t cantSuperficies, SDL_Rect *regiones,
+                                       int32_t anchoMax, int32_t altoMax)
+{
+    int32_t anchoCelda = 0, altoCelda = 0;
+    size_t cantValidas = 0;
+
+    for (size_t i = 0; i < cantSuperficies; i++) {
+        regiones[i] = (SDL_Rect){0, 0, 0, 0};
+        if (!superficies[i]) {
+            continue;
+        }
+        if (superficies[i]->w > anchoCelda) anchoCelda = superficies[i]->w;
+        if (superficies[i]->h > altoCelda) altoCelda = superficies[i]->h;
+        cantValidas++;
+    }
+
+    if (cantValidas == 0) {
+        return NULL;
+    }
+
+    // Grilla lo mas cuadrada posible para no exceder el tamano maximo de textura
+    int32_t columnas = (int32_t)ceil(sqrt((double)cantValidas));
+    int32_t filas = (int32_t)((cantValidas + columnas - 1) / columnas);
+    int32_t anchoAtlas = columnas * (anchoCelda + SEPARACION_ATLAS);
+    int32_t altoAtlas = filas * (altoCelda + SEPARACION_ATLAS);
+
+    if (anchoMax > 0 && (anchoAtlas > anchoMax || altoAtlas > altoMax)) {
+        fprintf(stderr, "Error: El atlas de %dx%d excede el maximo del renderizador\n", anchoAtlas, altoAtlas);
+        return NULL;
+    }
+
+    SDL_Surface *lienzo = SDL_CreateRGBSurfaceWithFormat(0, anchoAtlas, altoAtlas, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!lienzo) {
+        fprintf(stderr, "Error: No se pudo crear el atlas de imagenes: %s\n", SDL_GetError());
+        return NULL;
+    }
+    SDL_FillRect(lienzo, NULL, SDL_MapRGBA(lienzo->format, 0, 0, 0, 0));
+
+    size_t celda = 0;
+    for (size_t i = 0; i < cantSuperficies; i++) {
+        if (!superficies[i]) {
+            continue;
+        }
+
+        regiones[i] = (SDL_Rect){
+            (int32_t)(celda % columnas) * (anchoCelda + SEPARACION_ATLAS),
+            (int32_t)(celda / columnas) * (altoCelda + SEPARACION_ATLAS),
+            superficies[i]->w,
+            superficies[i]->h
+        };
+        celda++;
+
+        SDL_BlendMode modoPrevio;
+        SDL_GetSurfaceBlendMode(superficies[i], &modoPrevio);
+        SDL_SetSurfaceBlendMode(superficies[i], SDL_BLENDMODE_NONE); // Copia el alfa sin mezclarlo
+        SDL_Rect destino = regiones[i];
+        SDL_BlitSurface(superficies[i], NULL, lienzo, &destino);
+        SDL_SetSurfaceBlendMode(superficies[i], modoPrevio);
+    }
+
+    return lienzo;
+}
+
+SDL_Texture* imagenes_crear_atlas(SDL_Renderer *renderer, SDL_Surface *const *superficies, size_t cantSuperficies, SDL_Rect *regiones)
+{
+    int32_t anchoMax = 0, altoMax = 0;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        anchoMax = info.max_texture_width;
+        altoMax = info.max_texture_height;
+    }
+
+    SDL_Surface *lienzo = imagenes_empaquetar_atlas(superficies, cantSuperficies, regiones, anchoMax, altoMax);
+    if (!lienzo) {
+        return NULL;
+    }
+
+    SDL_Texture *atlas = SDL_CreateTextureFromSurface(renderer, lienzo);
+    SDL_FreeSurface(lienzo);
+
+    if (!atlas) {
+        fprintf(stderr, "Error: No se pudo crear la textura del atlas: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+    return atlas;
+}
+
+SDL_Texture* imagenes_crear_textura_tramos(SDL_Renderer *renderer, const SDL_Surface *superficie)
+{
+    SDL_Texture *textura = SDL_CreateTexture(renderer, superficie->format->format, SDL_TEXTUREACCESS_STATIC,
+                                             superficie->w, superficie->h);
+    if (!textura) {
+        fprintf(stderr, "Error: No se pudo crear la textura: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    SDL_SetTextureBlendMode(textura, SDL_BLENDMODE_BLEND);
+
+    return textura;
+}
+
+int32_t imagenes_subir_tramo(SDL_Texture *textura, const SDL_Surface *superficie, int32_t filaInicial, int32_t cantFilas)
+{
+    if (filaInicial >= superficie->h) {
+        return superficie->h;
+    }
+    if (filaInicial + cantFilas > superficie->h) {
+        cantFilas = superficie->h - filaInicial;
+    }
+
+    SDL_Rect tramo = {0, filaInicial, superficie->w, cantFilas};
+    const uint8_t *pixeles = (const uint8_t*)superficie->pixels + (size_t)filaInicial * superficie->pitch;
+    if (SDL_UpdateTexture(textura, &tramo, pixeles, superficie->pitch) != 0) {
+        fprintf(stderr, "Error: No se pudo subir el tramo de textura: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    return filaInicial + cantFilas;
+}
+
 void imagenes_finalizar(void)
 {
     IMG_Quit();
@@ -22,7 +22,8 @@ tFormatosImg imagenes_inicializar(void);
 /**
  * @brief Carga una imagen directamente en la memoria de la GPU.
  * * * Se recomienda para imagenes que se renderizan frecuentemente y
- * permaneceran sin cambios durante su vida util.
+ * permaneceran sin cambios durante su vida util. Equivale a
+ * 'imagenes_cargar_gpu_escalada' con el tamano original.
  *
  * @param renderer Puntero al renderizador de SDL.
  * @param path Ruta al archivo.
@@ -33,18 +34,98 @@ tFormatosImg imagenes_inicializar(void);
  */
 SDL_Texture* imagenes_cargar_gpu(SDL_Renderer *renderer, const char *path);
 
+/**
+ * @brief Carga una imagen en la GPU escalada a un tamano fijo.
+ * * * La imagen decodificada se guarda en la cache de disco ya convertida al formato
+ * nativo del renderizador y escalada, con la ruta, la fecha del archivo y el tamano
+ * como clave. Las cargas siguientes crean la textura desde esos pixeles sin volver
+ * a decodificar el PNG o JPG.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param path Ruta al archivo.
+ * @param ancho Ancho de la textura, o 0 para el tamano original.
+ * @param alto Alto de la textura, o 0 para el tamano original.
+ *
+ * @return SDL_Texture* Puntero a la textura, o NULL si fallo la carga.
+ *
+ * @note La textura debe ser liberada con la funcion 'SDL_DestroyTexture' al finalizar su uso.
+ */
+SDL_Texture* imagenes_cargar_gpu_escalada(SDL_Renderer *renderer, const char *path, int32_t ancho, int32_t alto);
+
 /**
  * @brief Carga una imagen en la memoria RAM.
  * * * Se utiliza cuando se desea tener mayor control y acceso a la informacion de
  * la imagen, como por ejemplo para acceder a los valores de sus pixeles y/o modificarlos.
  *
  * @param path Ruta al archivo.
- * @return SDL_Surface* Puntero a la superficie en RAM, o NULL si fallo la carga.
+ * @return SDL_Surface* Puntero a la superficie RGBA32 en RAM, o NULL si fallo la carga.
  *
  * @note La superficie debe ser liberada con la funcion 'SDL_FreeSurface' al finalizar su uso.
  */
 SDL_Surface* imagenes_cargar_ram(const char *path);
 
+/**
+ * @brief Empaqueta varias superficies en una unica textura (atlas).
+ * * * Las superficies se ubican por filas dentro de una grilla y se copian tal cual,
+ * incluido su canal alfa. Dibujar cualquiera de ellas consiste en usar la textura
+ * del atlas con la region correspondiente como origen, sin cambiar de textura.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param superficies Array de punteros a superficies. Las entradas NULL se omiten.
+ * @param cantSuperficies Cantidad de elementos del array.
+ * @param regiones Array de salida con 'cantSuperficies' elementos. Recibe la region de
+ * cada superficie dentro del atlas, o un rectangulo vacio si la entrada era NULL.
+ *
+ * @return SDL_Texture* Puntero a la textura del atlas, o NULL si fallo la creacion.
+ *
+ * @note La textura debe ser liberada con la funcion 'SDL_DestroyTexture' al finalizar su uso.
+ * Las superficies no se modifican y siguen perteneciendo a quien llama.
+ */
+SDL_Texture* imagenes_crear_atlas(SDL_Renderer *renderer, SDL_Surface *const *superficies, size_t cantSuperficies, SDL_Rect *regiones);
+
+/**
+ * @brief Empaqueta varias superficies en una unica superficie (atlas) en RAM.
+ * * * Es la parte de 'imagenes_crear_atlas' que no usa el renderizador, por lo que
+ * puede ejecutarse fuera del hilo principal.
+ *
+ * @param superficies Array de punteros a superficies. Las entradas NULL se omiten.
+ * @param cantSuperficies Cantidad de elementos del array.
+ * @param regiones Array de salida con 'cantSuperficies' elementos (ver 'imagenes_crear_atlas').
+ * @param anchoMax Ancho maximo permitido, o 0 para no limitarlo.
+ * @param altoMax Alto maximo permitido.
+ *
+ * @return SDL_Surface* Superficie RGBA32 con el atlas, o NULL si fallo la creacion.
+ *
+ * @note La superficie debe ser liberada con la funcion 'SDL_FreeSurface' al finalizar su uso.
+ */
+SDL_Surface* imagenes_empaquetar_atlas(SDL_Surface *const *superficies, size_t cantSuperficies, SDL_Rect *regiones,
+                                       int32_t anchoMax, int32_t altoMax);
+
+/**
+ * @brief Crea una textura vacia con el tamano y formato de una superficie.
+ * * * Se completa con 'imagenes_subir_tramo', repartiendo la subida entre varios cuadros.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param superficie Superficie que se va a subir.
+ *
+ * @return SDL_Texture* Puntero a la textura, o NULL si fallo la creacion.
+ *
+ * @note La textura debe ser liberada con la funcion 'SDL_DestroyTexture' al finalizar su uso.
+ */
+SDL_Texture* imagenes_crear_textura_tramos(SDL_Renderer *renderer, const SDL_Surface *superficie);
+
+/**
+ * @brief Copia un tramo de filas de una superficie a su textura.
+ *
+ * @param textura Textura creada con 'imagenes_crear_textura_tramos'.
+ * @param superficie Superficie de origen.
+ * @param filaInicial Primera fila del tramo.
+ * @param cantFilas Cantidad de filas a copiar.
+ *
+ * @return int32_t Fila siguiente al tramo copiado (igual al alto al terminar), o -1 si fallo.
+ */
+int32_t imagenes_subir_tramo(SDL_Texture *textura, const SDL_Surface *superficie, int32_t filaInicial, int32_t cantFilas);
+
 /**
  * @brief Libera los recursos de SDL_image.
  */
@@ -4,6 +4,8 @@
 #include "imagenes.h"
 #include "presentacion.h"
 #include "menu.h"
+#include "recursos.h"
+#include "paquete.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -11,63 +13,269 @@
 #include <math.h>
 
 /* ============================================================
-   FUNCIONES PÚBLICAS
+   FUNCIONES INTERNAS
    ============================================================ */
 
-tError juego_inicializar(tJuego *juego)
+#define ALTO_LINEA_HUD  30
+
+/* Tareas del arranque que corren en hilos aparte (ver _lanzar_carga_inicial) */
+#define TAREA_AUDIO          0
+#define TAREA_MELODIA        1
+#define TAREA_FUENTE_GRANDE  0
+#define TAREA_FUENTE_CHICA   1
+#define RUTA_MELODIA         "snd/melodia2.mp3"
+
+typedef struct {
+    const char *path;
+    uint32_t    tam;
+} tFuenteInicial;
+
+static const tFuenteInicial FUENTES_INICIALES[] = {
+    { "fnt/IBMPlexMono-Regular.ttf", 48 },   /* TAREA_FUENTE_GRANDE: títulos */
+    { "fnt/IBMPlexMono-Regular.ttf", 24 },   /* TAREA_FUENTE_CHICA: stats/menú */
+};
+
+/* Dato de una línea de estadísticas del HUD. Se compara con memcmp, así que
+   siempre se arma partiendo de una estructura en cero. */
+typedef struct {
+    char    nombre[32];
+    int     puntos;
+    int     aciertos;
+    int     intentos;
+    int     racha;
+    uint8_t dosJugadores;
+    uint8_t marcado;      /* ">> " delante del jugador en turno */
+    uint8_t resaltado;    /* amarillo para el jugador en turno */
+} tLineaHUD;
+
+/* Dato del botón Cancelar. */
+typedef struct {
+    int  ancho;
+    int  alto;
+    char texto[16];
+} tBotonHUD;
+
+static SDL_Texture* _actualizar_linea_hud(SDL_Renderer *renderer, void *dato, void *datoNuevo, void *extra)
 {
-    /* ---- SDL base ---- */
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
-        fprintf(stderr, "%s\n", SDL_GetError());
-        return ERR_SDL;
-    }
+    (void)dato;
+    const tLineaHUD *l = (const tLineaHUD*)datoNuevo;
+    SDL_Color blanco   = {255,255,255,255};
+    SDL_Color amarillo = {255,255,100,255};
+    char linea[256];
+
+    if (l->dosJugadores)
+        snprintf(linea, sizeof(linea), "%s%s  Pts:%d  Ac:%d  Int:%d  Racha:%d",
+                 l->marcado ? ">> " : "   ", l->nombre,
+                 l->puntos, l->aciertos, l->intentos, l->racha);
+    else
+        snprintf(linea, sizeof(linea), "%s  Pts:%d  Aciertos:%d  Intentos:%d  Racha:%d",
+                 l->nombre, l->puntos, l->aciertos, l->intentos, l->racha);
+
+    return texto_crear_textura(renderer, (TTF_Font*)extra, linea, l->resaltado ? amarillo : blanco);
+}
 
-    memset(juego, 0, sizeof(tJuego));
-    juego->anchoVentana = ANCHO_VENTANA;
-    juego->altoVentana  = ALTO_VENTANA;
+/* El botón se arma en una superficie: una textura estática no se pierde
+   si el driver descarta el contenido de las texturas target. */
+static SDL_Texture* _actualizar_boton_hud(SDL_Renderer *renderer, void *dato, void *datoNuevo, void *extra)
+{
+    (void)dato;
+    const tBotonHUD *b = (const tBotonHUD*)datoNuevo;
+    SDL_Surface *sup = SDL_CreateRGBSurfaceWithFormat(0, b->ancho, b->alto, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sup) return NULL;
+
+    uint32_t blanco = SDL_MapRGBA(sup->format, 255, 255, 255, 255);
+    SDL_FillRect(sup, NULL, blanco);
+    SDL_Rect interior = { 1, 1, b->ancho - 2, b->alto - 2 };
+    SDL_FillRect(sup, &interior, SDL_MapRGBA(sup->format, 200, 50, 50, 255));
+
+    SDL_Surface *texto = TTF_RenderUTF8_Blended((TTF_Font*)extra, b->texto, (SDL_Color){255,255,255,255});
+    if (texto) {
+        SDL_Rect destino = { (b->ancho - texto->w) / 2, (b->alto - texto->h) / 2, texto->w, texto->h };
+        SDL_BlitSurface(texto, NULL, sup, &destino);
+        SDL_FreeSurface(texto);
+    }
 
-    juego->ventana = SDL_CreateWindow("Juego de la Memoria",
-                                     SDL_WINDOWPOS_CENTERED,
-                                     SDL_WINDOWPOS_CENTERED,
-                                     juego->anchoVentana,
-                                     juego->altoVentana,
-                                     SDL_WINDOW_SHOWN);
-    if (!juego->ventana) { fprintf(stderr, "%s\n", SDL_GetError()); return ERR_SDL; }
+    SDL_Texture *textura = SDL_CreateTextureFromSurface(renderer, sup);
+    SDL_FreeSurface(sup);
+    return textura;
+}
 
-    juego->renderer = SDL_CreateRenderer(juego->ventana, -1, SDL_RENDERER_ACCELERATED);
-    if (!juego->renderer) { fprintf(stderr, "%s\n", SDL_GetError()); return ERR_SDL; }
-    SDL_SetRenderDrawBlendMode(juego->renderer, SDL_BLENDMODE_BLEND);
+/* Crea los elementos del HUD de la partida. Sin fuente no hay HUD. */
+static void _crear_hud(tJuego *juego)
+{
+    if (!juego->fuenteChica) return;
 
-    /* ---- Audio ---- */
-    tFormatosSnd fmtSnd = sonidos_inicializar();
-    if (fmtSnd != SONIDO_ERR) {
-        juego->audioInicializado = 1;
-        juego->melodia = sonidos_cargar("snd/melodia2.mp3");
-        if (!juego->melodia) {
-            fprintf(stderr, "Aviso: melodia.mp3 no encontrada\n");
-        }
-    } else {
-        juego->audioInicializado = 0;
+    tLineaHUD linea;
+    memset(&linea, 0, sizeof(linea));
+    for (int j = 0; j < 2; ++j) {
+        juego->hudJugador[j] = hud_inicializar(juego->renderer, 0, 0, &linea, sizeof(linea),
+                                               juego->fuenteChica, _actualizar_linea_hud, NULL);
     }
 
-    /* ---- TTF ---- */
-    tError err;
-    if ((err = texto_inicializar()) != TODO_OK) return err;
-    juego->fuenteGrande = texto_cargar_fuente("fnt/IBMPlexMono-Regular.ttf", 48);
-    juego->fuenteChica  = texto_cargar_fuente("fnt/IBMPlexMono-Regular.ttf", 24);
+    tBotonHUD boton;
+    memset(&boton, 0, sizeof(boton));
+    juego->hudCancelar = hud_inicializar(juego->renderer, 0, 0, &boton, sizeof(boton),
+                                         juego->fuenteChica, _actualizar_boton_hud, NULL);
+}
 
-    /* ---- SDL_image ---- */
-    if ((err = imagenes_inicializar()) != (IMAGEN_BMP | IMAGEN_JPG | IMAGEN_PNG)) {
-        fprintf(stderr, "Aviso: no se pudieron cargar todos los formatos de imagen\n");
-    }
+/* Actualiza (solo si cambió) y dibuja la línea de un jugador, alineada a la izquierda. */
+static void _dibujar_linea_hud(tHUD *hud, const tLineaHUD *linea, int32_t x, int32_t y)
+{
+    if (!hud) return;
+    hud_actualizar_dato(hud, (void*)linea);
 
-    juego->fondo = imagenes_cargar_gpu(juego->renderer, "img/background.jpg");
+    int32_t ancho, alto;
+    hud_obtener_tamano(hud, &ancho, &alto);
+    hud_actualizar_posicion_abs(hud, x + ancho / 2, y + alto / 2, 0);
+    hud_dibujar(hud);
+}
 
-    /* ---- Framebuffers ---- */
-    for (int i = 0; i < FB_CANT; ++i)
+/* Recrea las capas al tamaño actual de la ventana. */
+static void _recrear_framebuffers(tJuego *juego)
+{
+    for (int i = 0; i < FB_CANT; ++i) {
+        if (juego->framebuffers[i])
+            SDL_DestroyTexture(juego->framebuffers[i]);
         juego->framebuffers[i] = graficos_crear_framebuffer(juego->renderer,
                                     juego->anchoVentana, juego->altoVentana);
+    }
+    juego->capasSucias = CAPAS_TODAS;
+}
+
+/* ---- Arranque en paralelo ----
+   El audio (abrir el dispositivo y la melodía) y las fuentes se
+   cargan en dos hilos mientras el principal crea la ventana, el fondo y las
+   capas. Cada uno se une recién antes de su primer uso. */
+
+static void* _abrir_audio(void *contexto)
+{
+    tJuego *juego = (tJuego*)contexto;
+    juego->audioInicializado = (sonidos_inicializar(&juego->ajustesAudio) != SONIDO_ERR);
+    return juego;
+}
+
+static void* _cargar_melodia(void *contexto)
+{
+    tJuego *juego = (tJuego*)contexto;
+    if (!juego->audioInicializado) return NULL;
 
+    /* En streaming: solo se abre el archivo, se decodifica mientras suena */
+    tSonido *melodia = sonidos_cargar_musica(RUTA_MELODIA);
+    if (!melodia) fprintf(stderr, "Aviso: melodia.mp3 no encontrada\n");
+    return melodia;
+}
+
+static void _descartar_melodia(void *resultado)
+{
+    sonidos_destruir((tSonido*)resultado);
+}
+
+static void* _cargar_fuente_inicial(void *contexto)
+{
+    const tFuenteInicial *f = (const tFuenteInicial*)contexto;
+    return texto_cargar_fuente(f->path, f->tam);
+}
+
+static void _descartar_fuente(void *resultado)
+{
+    texto_destruir_fuente((TTF_Font*)resultado);
+}
+
+/* Lanza los hilos del arranque. Si alguno no se puede crear, su trabajo se
+   hace acá mismo en el hilo principal. */
+static void _lanzar_carga_inicial(tJuego *juego)
+{
+    juego->cargaAudio = cargador_crear();
+    if (juego->cargaAudio) {
+        cargador_agregar(juego->cargaAudio, _abrir_audio, NULL, juego);
+        cargador_agregar(juego->cargaAudio, _cargar_melodia, _descartar_melodia, juego);
+        if (cargador_iniciar(juego->cargaAudio) != TODO_OK) {
+            cargador_destruir(juego->cargaAudio);
+            juego->cargaAudio = NULL;
+        }
+    }
+    if (!juego->cargaAudio) {
+        _abrir_audio(juego);
+        juego->melodia = _cargar_melodia(juego);
+    }
+
+    /* FreeType no admite abrir fuentes desde dos hilos a la vez: hasta
+       _esperar_fuentes el hilo principal no carga ninguna */
+    juego->cargaFuentes = cargador_crear();
+    if (juego->cargaFuentes) {
+        for (int i = 0; i < 2; ++i)
+            cargador_agregar(juego->cargaFuentes, _cargar_fuente_inicial, _descartar_fuente,
+                             (void*)&FUENTES_INICIALES[i]);
+        if (cargador_iniciar(juego->cargaFuentes) != TODO_OK) {
+            cargador_destruir(juego->cargaFuentes);
+            juego->cargaFuentes = NULL;
+        }
+    }
+    if (!juego->cargaFuentes) {
+        juego->fuenteGrande = _cargar_fuente_inicial((void*)&FUENTES_INICIALES[TAREA_FUENTE_GRANDE]);
+        juego->fuenteChica  = _cargar_fuente_inicial((void*)&FUENTES_INICIALES[TAREA_FUENTE_CHICA]);
+    }
+}
+
+static void _esperar_fuentes(tJuego *juego)
+{
+    if (!juego->cargaFuentes) return;
+    juego->fuenteGrande = (TTF_Font*)cargador_esperar(juego->cargaFuentes, TAREA_FUENTE_GRANDE);
+    juego->fuenteChica  = (TTF_Font*)cargador_esperar(juego->cargaFuentes, TAREA_FUENTE_CHICA);
+    cargador_destruir(juego->cargaFuentes);
+    juego->cargaFuentes = NULL;
+}
+
+/* Une solo la apertura del dispositivo: la melodía puede seguir abriéndose.
+   Se recuerda el buffer que pasó la medición para no repetirla en el próximo
+   arranque. El pedido no se toca: un corte causado por la propia carga
+   inicial no debe dejar el buffer grande para siempre. */
+static void _esperar_audio(tJuego *juego)
+{
+    if (juego->cargaAudio) cargador_esperar(juego->cargaAudio, TAREA_AUDIO);
+
+    if (!juego->autoplay && juego->audioInicializado && juego->configuracion.bajaLatencia)
+        juego->configuracion.bufferVerificado = juego->ajustesAudio.muestrasVerificadas;
+}
+
+/* La presentación une el audio recién cuando va a sonar, con su primer cuadro ya en pantalla */
+static void _esperar_audio_presentacion(void *contexto)
+{
+    _esperar_audio((tJuego*)contexto);
+}
+
+static void _esperar_melodia(tJuego *juego)
+{
+    if (!juego->cargaAudio) return;
+    juego->melodia = (tSonido*)cargador_esperar(juego->cargaAudio, TAREA_MELODIA);
+    cargador_destruir(juego->cargaAudio);
+    juego->cargaAudio = NULL;
+}
+
+/* Crea la partida con la configuración actual. Fuera del benchmark los
+   recursos se cargan en segundo plano para no congelar la ventana. */
+static tMemoria* _crear_partida(tJuego *juego)
+{
+    if (juego->autoplay) {
+        return memoria_crear(juego->renderer,
+                             juego->configuracion.filas,
+                             juego->configuracion.columnas,
+                             juego->configuracion.setFiguras,
+                             juego->audioInicializado,
+                             juego->configuracion.cantJugadores);
+    }
+
+    return memoria_crear_diferida(juego->renderer,
+                                  juego->configuracion.filas,
+                                  juego->configuracion.columnas,
+                                  juego->configuracion.setFiguras,
+                                  juego->audioInicializado,
+                                  juego->configuracion.cantJugadores);
+}
+
+/* Pide los nombres y muestra el menú hasta que se elige jugar. */
+static tError _configurar_partida(tJuego *juego)
+{
     /* ---- Pedir SOLO el nombre del jugador 1 al inicio ---- */
     juego->nombreJugador1[0] = '\0';
     juego->nombreJugador2[0] = '\0';
@@ -79,9 +287,6 @@ tError juego_inicializar(tJuego *juego)
                          juego->nombreJugador1,
                          sizeof(juego->nombreJugador1));
 
-    /* ---- Cargar configuración persistente ---- */
-    juego->configuracion = config_cargar(RUTA_CONFIG);
-
     /* ---- Menú gráfico (Navegación con Highscores) ---- */
     int navegando = 1;
     while (navegando) {
@@ -125,7 +330,6 @@ tError juego_inicializar(tJuego *juego)
             navegando = 0;
         }
         else {
-            juego->corriendo = 0;
             return ERR_SDL;
         }
     }
@@ -133,20 +337,126 @@ tError juego_inicializar(tJuego *juego)
     /* Guardar configuración para la próxima sesión */
     config_guardar(RUTA_CONFIG, &juego->configuracion);
 
-    /* ---- Crear partida de memoria ---- */
-    srand((unsigned)time(NULL));
-    juego->partida = memoria_crear(juego->renderer,
-                                   juego->configuracion.filas,
-                                   juego->configuracion.columnas,
-                                   juego->configuracion.setFiguras,
-                                   juego->audioInicializado,
-                                   juego->configuracion.cantJugadores);
+    return TODO_OK;
+}
+
+/* ============================================================
+   FUNCIONES PÚBLICAS
+   ============================================================ */
+
+tError juego_inicializar(tJuego *juego, const tOpciones *opciones)
+{
+    tOpciones porDefecto = opciones_por_defecto();
+    if (!opciones) opciones = &porDefecto;
+
+    /* Sin pantalla ni placa de sonido: drivers que no necesitan hardware,
+       salvo que el entorno ya indique otros */
+    if (opciones->autoplay) {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    }
+    if (opciones->renderer)
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, opciones->renderer);
+
+    /* ---- SDL base ---- */
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+        fprintf(stderr, "%s\n", SDL_GetError());
+        return ERR_SDL;
+    }
+
+    /* ---- Paquete de recursos: si no está, se leen los archivos sueltos ---- */
+    paquete_abrir(RUTA_PAQUETE);
+
+    memset(juego, 0, sizeof(tJuego));
+    juego->autoplay     = opciones->autoplay;
+    juego->anchoVentana = ANCHO_VENTANA;
+    juego->altoVentana  = ALTO_VENTANA;
+
+    /* ---- Configuración persistente: el audio se abre con sus ajustes ----
+       El benchmark usa siempre el buffer seguro en mono, como antes */
+    if (juego->autoplay) {
+        juego->ajustesAudio.muestrasBuffer = BUFFER_AUDIO_SEGURO;
+        juego->ajustesAudio.canales        = 1;
+        juego->ajustesAudio.bajaLatencia   = 0;
+    } else {
+        juego->configuracion = config_cargar(RUTA_CONFIG);
+        juego->ajustesAudio.muestrasBuffer = juego->configuracion.bufferAudio;
+        juego->ajustesAudio.canales        = juego->configuracion.canalesAudio;
+        juego->ajustesAudio.bajaLatencia   = (uint8_t)juego->configuracion.bajaLatencia;
+        juego->ajustesAudio.muestrasVerificadas = juego->configuracion.bufferVerificado;
+    }
+
+    juego->ventana = SDL_CreateWindow("Juego de la Memoria",
+                                     SDL_WINDOWPOS_CENTERED,
+                                     SDL_WINDOWPOS_CENTERED,
+                                     juego->anchoVentana,
+                                     juego->altoVentana,
+                                     SDL_WINDOW_SHOWN);
+    if (!juego->ventana) { fprintf(stderr, "%s\n", SDL_GetError()); return ERR_SDL; }
+
+    /* En autoplay se acepta cualquier renderer, incluido el de software */
+    juego->renderer = SDL_CreateRenderer(juego->ventana, -1,
+                                         juego->autoplay ? 0 : SDL_RENDERER_ACCELERATED);
+    if (!juego->renderer) { fprintf(stderr, "%s\n", SDL_GetError()); return ERR_SDL; }
+    SDL_SetRenderDrawBlendMode(juego->renderer, SDL_BLENDMODE_BLEND);
+
+    /* ---- TTF (antes de abrir fuentes en el hilo de carga) ---- */
+    tError err;
+    if ((err = texto_inicializar()) != TODO_OK) return err;
+
+    /* ---- Audio y fuentes en segundo plano ---- */
+    _lanzar_carga_inicial(juego);
+
+    /* ---- SDL_image ---- */
+    if ((err = imagenes_inicializar()) != (IMAGEN_BMP | IMAGEN_JPG | IMAGEN_PNG)) {
+        fprintf(stderr, "Aviso: no se pudieron cargar todos los formatos de imagen\n");
+    }
+
+    /* El fondo se guarda en la cache ya escalado al tamaño de la ventana */
+    juego->fondo = imagenes_cargar_gpu_escalada(juego->renderer, "img/background.jpg",
+                                                (int32_t)juego->anchoVentana,
+                                                (int32_t)juego->altoVentana);
+
+    /* ---- Framebuffers ---- */
+    _recrear_framebuffers(juego);
+
+    /* ---- HUD de la partida: primer uso de las fuentes ---- */
+    _esperar_fuentes(juego);
+    _crear_hud(juego);
+
+    /* ---- Medición de rendimiento ---- */
+    juego->rendimiento = rendimiento_crear();
+    if (!juego->rendimiento) return ERR_MEMORIA;
+    juego->monitor = monitor_crear(juego->renderer);
+    if (!juego->monitor) {
+        fprintf(stderr, "Aviso: no se pudo crear el monitor de rendimiento\n");
+    }
+
+    /* ---- Configuración de la partida: el audio se une con el sonido de la presentación ---- */
+    if (juego->autoplay) {
+        juego->configuracion = config_por_defecto();
+        juego->configuracion.filas    = opciones->filas;
+        juego->configuracion.columnas = opciones->columnas;
+        juego->pasoFijoMs = LOOP_DELAY;
+        srand(opciones->semilla);
+    } else {
+        presentacion_esperar_audio(_esperar_audio_presentacion, juego);
+        err = _configurar_partida(juego);
+        presentacion_esperar_audio(NULL, NULL);
+        if (err != TODO_OK) return err;
+        srand((unsigned)time(NULL));
+    }
+
+    /* ---- Crear partida de memoria: necesita saber si hay audio ---- */
+    _esperar_audio(juego);
+    juego->partida = _crear_partida(juego);
     if (!juego->partida) {
         fprintf(stderr, "Error al crear la partida de memoria.\n");
         return ERR_MEMORIA;
     }
 
-    /* ---- Música de fondo ---- */
+    /* ---- Música de fondo: se abrió mientras se cargaba el nombre ---- */
+    _esperar_melodia(juego);
     if (juego->audioInicializado && juego->melodia)
         sonidos_reproducir(juego->melodia, -1);
 
@@ -159,6 +469,8 @@ tAccionMenu juego_procesar_eventos(tJuego *juego)
     tAccionMenu accion = -1;   // ninguna acción por defecto
     SDL_Event evento;
 
+    rendimiento_iniciar(juego->rendimiento, FASE_EVENTOS);
+
     // Rectángulo del botón Cancelar (arriba a la derecha)
     SDL_Rect botonCancelar = { juego->anchoVentana - 170, 20, 150, 40 };
 
@@ -169,6 +481,25 @@ tAccionMenu juego_procesar_eventos(tJuego *juego)
             accion = ACCION_SALIR;
         }
 
+        // Cambio de tamaño: las capas se recrean y se redibujan completas
+        else if (evento.type == SDL_WINDOWEVENT && evento.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+            juego->anchoVentana = (uint32_t)evento.window.data1;
+            juego->altoVentana  = (uint32_t)evento.window.data2;
+            _recrear_framebuffers(juego);
+            memoria_redimensionar(juego->partida, (int)juego->anchoVentana, (int)juego->altoVentana);
+        }
+
+        // La ventana volvió a mostrarse: alcanza con presentar de nuevo las capas
+        else if (evento.type == SDL_WINDOWEVENT && evento.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            juego_invalidar_capas(juego, CAPA_COMPOSICION);
+        }
+
+        // El driver descartó el contenido de las texturas target: capas y caras horneadas
+        else if (evento.type == SDL_RENDER_TARGETS_RESET || evento.type == SDL_RENDER_DEVICE_RESET) {
+            memoria_invalidar_caras(juego->partida);
+            juego_invalidar_capas(juego, CAPAS_TODAS);
+        }
+
         // Clic con el mouse
         else if (evento.type == SDL_MOUSEBUTTONDOWN && evento.button.button == SDL_BUTTON_LEFT) {
             int mx = evento.button.x;
@@ -189,8 +520,15 @@ tAccionMenu juego_procesar_eventos(tJuego *juego)
 
         // Teclas
         else if (evento.type == SDL_KEYDOWN) {
+            // F3: mostrar u ocultar el monitor de rendimiento
+            if (evento.key.keysym.sym == SDLK_F3) {
+                if (juego->monitor) {
+                    monitor_alternar(juego->monitor);
+                    juego_invalidar_capas(juego, CAPA_COMPOSICION);
+                }
+            }
             // ESC: salir del juego
-            if (evento.key.keysym.sym == SDLK_ESCAPE) {
+            else if (evento.key.keysym.sym == SDLK_ESCAPE) {
                 if (memoria_partida_terminada(juego->partida)) {
                     juego->corriendo = 0;
                     accion = ACCION_SALIR;
@@ -220,12 +558,7 @@ tAccionMenu juego_procesar_eventos(tJuego *juego)
                     juego->rankingGuardado = 0;
 
                     // Crear nueva partida con la misma configuración
-                    juego->partida = memoria_crear(juego->renderer,
-                                                   juego->configuracion.filas,
-                                                   juego->configuracion.columnas,
-                                                   juego->configuracion.setFiguras,
-                                                   juego->audioInicializado,
-                                                   juego->configuracion.cantJugadores);
+                    juego->partida = _crear_partida(juego);
 
                     if (!juego->partida) {
                         fprintf(stderr, "Error al reiniciar la partida.\n");
@@ -243,22 +576,27 @@ tAccionMenu juego_procesar_eventos(tJuego *juego)
         }
     }
 
+    rendimiento_terminar(juego->rendimiento, FASE_EVENTOS);
     return accion;
 }
 
 void juego_actualizar(tJuego *juego)
 {
+    rendimiento_iniciar(juego->rendimiento, FASE_ACTUALIZAR);
+
     static uint32_t ticksPrev = 0;
     uint32_t ticks = SDL_GetTicks();
-    uint32_t delta = ticksPrev ? (ticks - ticksPrev) : LOOP_DELAY;
+    uint32_t delta = juego->pasoFijoMs ? juego->pasoFijoMs
+                                       : (ticksPrev ? (ticks - ticksPrev) : LOOP_DELAY);
     ticksPrev = ticks;
 
     if (juego->partida)
         memoria_actualizar(juego->partida, delta);
 
-    /* ---- Guardar ranking al terminar la partida (una sola vez) ---- */
+    /* ---- Guardar ranking al terminar la partida (una sola vez) ----
+       Las partidas automáticas no tocan el ranking */
     if (juego->partida && memoria_partida_terminada(juego->partida)
-        && !juego->rankingGuardado)
+        && !juego->rankingGuardado && !juego->autoplay)
     {
         juego->ranking = ranking_cargar(RUTA_RANKING);
         if (juego->ranking)
@@ -283,70 +621,115 @@ void juego_actualizar(tJuego *juego)
             ranking_guardar(RUTA_RANKING, juego->ranking);
         }
         juego->rankingGuardado = 1;
+        juego_invalidar_capas(juego, CAPA(FB_HUD));
     }
+
+    rendimiento_terminar(juego->rendimiento, FASE_ACTUALIZAR);
+}
+
+void juego_invalidar_capas(tJuego *juego, uint32_t capas)
+{
+    juego->capasSucias |= capas;
+}
+
+void juego_esperar_eventos(tJuego *juego)
+{
+    /* Un cuadro pendiente no espera: se dibuja en la próxima vuelta */
+    if (juego->capasSucias) return;
+
+    /* El monitor se refresca aunque la escena no cambie */
+    if (monitor_visible(juego->monitor)) {
+        SDL_WaitEventTimeout(NULL, LOOP_DELAY);
+        return;
+    }
+
+    /* Sin cambios en curso la escena es estática: se bloquea hasta que llegue
+       un evento o venza el próximo temporizador de la partida. El evento
+       queda en la cola para juego_procesar_eventos. */
+    int32_t espera = juego->partida ? memoria_proximo_cambio_ms(juego->partida) : -1;
+    if (espera < 0)
+        SDL_WaitEvent(NULL);
+    else if (espera > 0)
+        SDL_WaitEventTimeout(NULL, espera);
 }
 
 void juego_renderizar(tJuego *juego)
 {
+    rendimiento_iniciar(juego->rendimiento, FASE_RENDERIZAR);
+
+    /* ---- Qué capas cambiaron desde el último cuadro ---- */
+    if (juego->partida) {
+        uint32_t cambios = memoria_consumir_cambios(juego->partida);
+        if (cambios & MEMORIA_CAMBIO_TABLERO)      juego->capasSucias |= CAPA(FB_ESCENA);
+        if (cambios & MEMORIA_CAMBIO_ESTADISTICAS) juego->capasSucias |= CAPA(FB_HUD);
+    } else {
+        juego->capasSucias |= CAPA(FB_ESCENA) | CAPA(FB_HUD);
+    }
+
+    /* Con el monitor visible se presenta cada cuadro para refrescarlo */
+    if (monitor_visible(juego->monitor)) juego->capasSucias |= CAPA_COMPOSICION;
+
+    /* Nada cambió: el último cuadro presentado sigue siendo válido */
+    if (!juego->capasSucias) {
+        rendimiento_terminar(juego->rendimiento, FASE_RENDERIZAR);
+        return;
+    }
+
     /* ---- Capa: fondo ---- */
-    graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_FONDO]);
-    graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,255});
-    if (juego->fondo) {
-        SDL_RenderCopy(juego->renderer, juego->fondo, NULL, NULL);
+    if (juego->capasSucias & CAPA(FB_FONDO)) {
+        rendimiento_iniciar(juego->rendimiento, FASE_CAPA_FONDO);
+        graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_FONDO]);
+        graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,255});
+        if (juego->fondo) {
+            SDL_RenderCopy(juego->renderer, juego->fondo, NULL, NULL);
+        }
+        rendimiento_terminar(juego->rendimiento, FASE_CAPA_FONDO);
     }
 
     /* ---- Capa: escena (tablero de cartas) ---- */
-    graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_ESCENA]);
-    graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,0});
-    if (juego->partida)
-        memoria_renderizar(juego->partida, juego->renderer);
+    if (juego->capasSucias & CAPA(FB_ESCENA)) {
+        rendimiento_iniciar(juego->rendimiento, FASE_CAPA_ESCENA);
+        graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_ESCENA]);
+        graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,0});
+        if (juego->partida)
+            memoria_renderizar(juego->partida, juego->renderer);
+        rendimiento_terminar(juego->rendimiento, FASE_CAPA_ESCENA);
+    }
 
     /* ---- Capa: HUD (estadísticas y nombres) ---- */
-    graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_HUD]);
-    graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,0});
+    if (juego->capasSucias & CAPA(FB_HUD)) {
+        rendimiento_iniciar(juego->rendimiento, FASE_CAPA_HUD);
+        graficos_cambiar_framebuffer(juego->renderer, juego->framebuffers[FB_HUD]);
+        graficos_borrar_pantalla(juego->renderer, &(SDL_Color){0,0,0,0});
+    }
 
-    if (juego->fuenteChica && juego->partida) {
-        SDL_Color blanco  = {255,255,255,255};
-        SDL_Color amarillo = {255,255,100,255};
+    if ((juego->capasSucias & CAPA(FB_HUD)) && juego->fuenteChica && juego->partida) {
         int terminada = memoria_partida_terminada(juego->partida);
+        tLineaHUD linea;
 
         if (juego->configuracion.cantJugadores == 2) {
             /* ---- Modo 2 jugadores ---- */
             int turno = memoria_obtener_turno(juego->partida);
             for (int j = 0; j < 2; ++j) {
-                int pts = 0, ac = 0, it = 0, rac = 0;
-                memoria_obtener_estadisticas_jugador(juego->partida, j, &pts, &ac, &it, &rac);
+                memset(&linea, 0, sizeof(linea));
+                memoria_obtener_estadisticas_jugador(juego->partida, j, &linea.puntos, &linea.aciertos,
+                                                     &linea.intentos, &linea.racha);
                 const char *nombre = (j == 0) ? juego->nombreJugador1 : juego->nombreJugador2;
                 if (!nombre[0]) nombre = (j == 0) ? "Jugador 1" : "Jugador 2";
-                char linea[256];
-                snprintf(linea, sizeof(linea), "%s%s  Pts:%d  Ac:%d  Int:%d  Racha:%d",
-                         (turno == j && !terminada) ? ">> " : "   ",
-                         nombre, pts, ac, it, rac);
-                SDL_Texture *tLinea = texto_crear_textura(juego->renderer,
-                    juego->fuenteChica, linea, (turno == j) ? amarillo : blanco);
-                if (tLinea) {
-                    int w, h; SDL_QueryTexture(tLinea, NULL, NULL, &w, &h);
-                    SDL_Rect dst = { 10, 10 + j*30, w, h };
-                    SDL_RenderCopy(juego->renderer, tLinea, NULL, &dst);
-                    SDL_DestroyTexture(tLinea);
-                }
+                snprintf(linea.nombre, sizeof(linea.nombre), "%s", nombre);
+                linea.dosJugadores = 1;
+                linea.marcado   = (turno == j && !terminada);
+                linea.resaltado = (turno == j);
+                _dibujar_linea_hud(juego->hudJugador[j], &linea, 10, 10 + j*ALTO_LINEA_HUD);
             }
         } else {
             /* ---- Modo 1 jugador ---- */
-            int pts = 0, ac = 0, it = 0, rac = 0;
-            memoria_obtener_estadisticas(juego->partida, &pts, &ac, &it, &rac);
+            memset(&linea, 0, sizeof(linea));
+            memoria_obtener_estadisticas(juego->partida, &linea.puntos, &linea.aciertos,
+                                         &linea.intentos, &linea.racha);
             const char *nombre = juego->nombreJugador1[0] ? juego->nombreJugador1 : "Jugador";
-            char linea[256];
-            snprintf(linea, sizeof(linea), "%s  Pts:%d  Aciertos:%d  Intentos:%d  Racha:%d",
-                     nombre, pts, ac, it, rac);
-            SDL_Texture *tLinea = texto_crear_textura(juego->renderer,
-                juego->fuenteChica, linea, blanco);
-            if (tLinea) {
-                int w, h; SDL_QueryTexture(tLinea, NULL, NULL, &w, &h);
-                SDL_Rect dst = { 10, 10, w, h };
-                SDL_RenderCopy(juego->renderer, tLinea, NULL, &dst);
-                SDL_DestroyTexture(tLinea);
-            }
+            snprintf(linea.nombre, sizeof(linea.nombre), "%s", nombre);
+            _dibujar_linea_hud(juego->hudJugador[0], &linea, 10, 10);
         }
 
         /* Pantalla de ranking al terminar la partida */
@@ -357,46 +740,56 @@ void juego_renderizar(tJuego *juego)
                                (int)juego->altoVentana);
 
             /* Mensaje adicional para reiniciar */
-            SDL_Texture *tMsg = texto_crear_textura(juego->renderer, juego->fuenteChica,
-                                                    "Presione ENTER para jugar otra vez",
-                                                    (SDL_Color){100,255,100,255});
-            if (tMsg) {
-                int w, h;
-                SDL_QueryTexture(tMsg, NULL, NULL, &w, &h);
-                SDL_Rect dst = { (juego->anchoVentana - w) / 2,
-                                 juego->altoVentana - 50, w, h };
-                SDL_RenderCopy(juego->renderer, tMsg, NULL, &dst);
-                SDL_DestroyTexture(tMsg);
-            }
+            const char *msg = "Presione ENTER para jugar otra vez";
+            int w;
+            texto_medir(juego->renderer, juego->fuenteChica, msg, &w, NULL);
+            texto_dibujar(juego->renderer, juego->fuenteChica, msg,
+                          ((int)juego->anchoVentana - w) / 2, juego->altoVentana - 50,
+                          (SDL_Color){100,255,100,255});
         }
 
     /* ---- Botón Cancelar ---- */
-        if (!terminada) {
+        if (!terminada && juego->hudCancelar) {
             SDL_Rect botonCancelar = { juego->anchoVentana - 170, 20, 150, 40 };
-            SDL_SetRenderDrawColor(juego->renderer, 200, 50, 50, 255);
-            SDL_RenderFillRect(juego->renderer, &botonCancelar);
-            SDL_SetRenderDrawColor(juego->renderer, 255, 255, 255, 255);
-            SDL_RenderDrawRect(juego->renderer, &botonCancelar);
-            
-            SDL_Texture *tCancelar = texto_crear_textura(juego->renderer, juego->fuenteChica, "Cancelar", blanco);
-            if (tCancelar) {
-                int w, h;
-                SDL_QueryTexture(tCancelar, NULL, NULL, &w, &h);
-                SDL_Rect dst = { botonCancelar.x + (botonCancelar.w - w)/2, 
-                                botonCancelar.y + (botonCancelar.h - h)/2, w, h };
-                SDL_RenderCopy(juego->renderer, tCancelar, NULL, &dst);
-                SDL_DestroyTexture(tCancelar);
-            }
+            tBotonHUD boton;
+            memset(&boton, 0, sizeof(boton));
+            boton.ancho = botonCancelar.w;
+            boton.alto  = botonCancelar.h;
+            snprintf(boton.texto, sizeof(boton.texto), "Cancelar");
+            hud_actualizar_dato(juego->hudCancelar, &boton);
+            hud_actualizar_posicion_abs(juego->hudCancelar,
+                                        botonCancelar.x + botonCancelar.w / 2,
+                                        botonCancelar.y + botonCancelar.h / 2, 0);
+            hud_dibujar(juego->hudCancelar);
         }
     }
 
-    /* ---- Composición final ---- */
+    if (juego->capasSucias & CAPA(FB_HUD))
+        rendimiento_terminar(juego->rendimiento, FASE_CAPA_HUD);
+
+    juego->capasSucias = 0;
+
+    /* ---- Composición final, con el monitor por encima de todas las capas ---- */
+    monitor_actualizar(juego->monitor);
     graficos_cambiar_framebuffer(juego->renderer, NULL);
-    graficos_renderizar(juego->renderer, juego->framebuffers, FB_CANT);
+    graficos_componer(juego->renderer, juego->framebuffers, FB_CANT);
+    monitor_dibujar(juego->monitor);
+
+    rendimiento_iniciar(juego->rendimiento, FASE_PRESENTAR);
+    SDL_RenderPresent(juego->renderer);
+    rendimiento_terminar(juego->rendimiento, FASE_PRESENTAR);
+
+    rendimiento_terminar(juego->rendimiento, FASE_RENDERIZAR);
 }
 
 void juego_destruir(tJuego *juego)
 {
+    /* Si el arranque no terminó, se espera a los hilos antes de liberar nada */
+    if (juego->cargaAudio)   cargador_destruir(juego->cargaAudio);
+    if (juego->cargaFuentes) cargador_destruir(juego->cargaFuentes);
+    juego->cargaAudio = NULL;
+    juego->cargaFuentes = NULL;
+
     if (juego->ranking) {
         vector_destroy(juego->ranking);
         juego->ranking = NULL;
@@ -406,12 +799,24 @@ void juego_destruir(tJuego *juego)
         memoria_destruir(juego->partida);
         juego->partida = NULL;
     }
+    memoria_finalizar();
 
     for (int i = 0; i < FB_CANT; ++i) {
         if (juego->framebuffers[i])
             SDL_DestroyTexture(juego->framebuffers[i]);
     }
 
+    for (int j = 0; j < 2; ++j) {
+        if (juego->hudJugador[j]) hud_destruir(juego->hudJugador[j]);
+    }
+    if (juego->hudCancelar) hud_destruir(juego->hudCancelar);
+
+    if (juego->monitor)     monitor_destruir(juego->monitor);
+    if (juego->rendimiento) rendimiento_destruir(juego->rendimiento);
+
+    /* La cache guarda fuentes, sonidos y texturas: se vacia antes de cerrar esos subsistemas */
+    recursos_finalizar();
+
     if (juego->fuenteGrande) texto_destruir_fuente(juego->fuenteGrande);
     if (juego->fuenteChica)  texto_destruir_fuente(juego->fuenteChica);
     texto_finalizar();
@@ -424,6 +829,9 @@ void juego_destruir(tJuego *juego)
     if (juego->fondo) SDL_DestroyTexture(juego->fondo);
     imagenes_finalizar();
 
+    /* Las fuentes y sonidos leídos del paquete ya se cerraron */
+    paquete_cerrar();
+
     if (juego->renderer) SDL_DestroyRenderer(juego->renderer);
     if (juego->ventana)  SDL_DestroyWindow(juego->ventana);
 
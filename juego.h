@@ -9,6 +9,11 @@
 #include "memoria.h"
 #include "config.h"
 #include "ranking.h"
+#include "opciones.h"
+#include "rendimiento.h"
+#include "monitor.h"
+#include "hud.h"
+#include "cargador.h"
 
 #include"menu.h"
 #define LOOP_DELAY      16
@@ -25,6 +30,11 @@ typedef enum {
     FB_CANT,
 } eFramebuffers;
 
+/* Máscara de una capa dentro de tJuego.capasSucias */
+#define CAPA(fb)          (1u << (fb))
+#define CAPAS_TODAS       (CAPA(FB_CANT) - 1)
+#define CAPA_COMPOSICION  CAPA(FB_CANT)   /* solo volver a presentar las capas */
+
 typedef enum {
     ESTADO_MENU,
     ESTADO_JUGANDO,
@@ -36,6 +46,7 @@ typedef struct {
     SDL_Window   *ventana;
     SDL_Renderer *renderer;
     SDL_Texture  *framebuffers[FB_CANT];
+    uint32_t      capasSucias;         /* CAPA(fb) de las capas a redibujar */
     SDL_Texture  *fondo;               /* textura de fondo */
     TTF_Font     *fuenteGrande;        /* tamaño 48 – títulos */
     TTF_Font     *fuenteChica;         /* tamaño 24 – stats/menú */
@@ -43,6 +54,7 @@ typedef struct {
     uint32_t      anchoVentana;
     uint32_t      altoVentana;
     uint8_t       audioInicializado;
+    tAjustesAudio ajustesAudio;        /* pedidos al abrir el audio; luego, los que quedaron */
     uint8_t       corriendo;
     char          nombreJugador1[32];
     char          nombreJugador2[32];
@@ -51,12 +63,22 @@ typedef struct {
     tVector      *ranking;           /* ranking top 10 */
     uint8_t       rankingGuardado;   /* 1 si ya se guardó el score */
     tEstadoJuego  estado;
+    uint8_t       autoplay;          /* 1 si la partida la juega el benchmark */
+    uint32_t      pasoFijoMs;        /* delta de juego_actualizar, o 0 para tiempo real */
+    tRendimiento *rendimiento;       /* tiempos de cada fase del cuadro */
+    tMonitor     *monitor;           /* overlay de rendimiento (F3) */
+    tHUD         *hudJugador[2];     /* línea de estadísticas de cada jugador */
+    tHUD         *hudCancelar;       /* botón Cancelar */
+    tCargador    *cargaAudio;        /* apertura del audio y melodía, o NULL ya unidos */
+    tCargador    *cargaFuentes;      /* fuentes grande y chica, o NULL ya unidas */
 } tJuego;
 
-tError juego_inicializar(tJuego *juego);
+tError juego_inicializar(tJuego *juego, const tOpciones *opciones);
 tAccionMenu juego_procesar_eventos(tJuego *juego);
 void   juego_actualizar(tJuego *juego);
 void   juego_renderizar(tJuego *juego);
+void   juego_invalidar_capas(tJuego *juego, uint32_t capas);
+void   juego_esperar_eventos(tJuego *juego);
 void   juego_destruir(tJuego *juego);
 
 #endif // JUEGO_H_INCLUDED
\ No newline at end of file
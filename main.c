@@ -22,21 +22,52 @@ Entrega: Sí
 #include "errores.h"
 #include "menu.h"
 #include "presentacion.h"
+#include "opciones.h"
+#include "benchmark.h"
+#include "paquete.h"
 
 int main(int argc, char* argv[])
 {
     tError err;
     tJuego juego;
+    tOpciones opciones;
 
-    if ((err = juego_inicializar(&juego)) != TODO_OK)
+    if ((err = opciones_parsear(argc, argv, &opciones)) != TODO_OK)
+    {
+        opciones_uso(argc > 0 ? argv[0] : NULL);
+        return err;
+    }
+
+    // Herramienta de empaquetado: no abre la ventana
+    if (opciones.rutaPaquete)
+    {
+        const char *directorios[] = { "img", "snd", "fnt" };
+        err = paquete_crear(opciones.rutaPaquete, directorios, sizeof(directorios) / sizeof(directorios[0]));
+        if (err != TODO_OK)
+            fprintf(stderr, "Error: %s\n", errores_obtener_detalle(err));
+        return err;
+    }
+
+    if ((err = juego_inicializar(&juego, &opciones)) != TODO_OK)
     {
         fprintf(stderr, "Error: %s\n", errores_obtener_detalle(err));
         return err;
     }
 
+    // Modo benchmark: sin menú ni espera de eventos
+    if (opciones.autoplay)
+    {
+        err = benchmark_ejecutar(&juego, &opciones);
+        if (err != TODO_OK)
+            fprintf(stderr, "Error: %s\n", errores_obtener_detalle(err));
+        juego_destruir(&juego);
+        return err;
+    }
+
     // Loop principal
     while (juego.corriendo)
     {
+        rendimiento_iniciar(juego.rendimiento, FASE_CUADRO);
         tAccionMenu accion = juego_procesar_eventos(&juego);
 
         if (accion == ACCION_VOLVER_MENU)
@@ -51,6 +82,7 @@ int main(int argc, char* argv[])
             }
             juego.rankingGuardado = 0;
 
+            tConfig anterior = juego.configuracion;
             int navegando = 1;
             while (navegando) {
                 tAccionMenu accionMenu = menu_mostrar(juego.renderer,
@@ -104,12 +136,19 @@ int main(int argc, char* argv[])
 
             config_guardar(RUTA_CONFIG, &juego.configuracion);
 
-            juego.partida = memoria_crear(juego.renderer,
-                                         juego.configuracion.filas,
-                                         juego.configuracion.columnas,
-                                         juego.configuracion.setFiguras,
-                                         juego.audioInicializado,
-                                         juego.configuracion.cantJugadores);
+            /* Con otro tablero el atlas anterior ya no se usa */
+            if (anterior.filas != juego.configuracion.filas ||
+                anterior.columnas != juego.configuracion.columnas ||
+                anterior.setFiguras != juego.configuracion.setFiguras) {
+                memoria_desalojar_atlas(anterior.filas, anterior.columnas, anterior.setFiguras);
+            }
+
+            juego.partida = memoria_crear_diferida(juego.renderer,
+                                                   juego.configuracion.filas,
+                                                   juego.configuracion.columnas,
+                                                   juego.configuracion.setFiguras,
+                                                   juego.audioInicializado,
+                                                   juego.configuracion.cantJugadores);
             if (!juego.partida) {
                 fprintf(stderr, "Error al crear la partida.\n");
                 juego.corriendo = 0;
@@ -122,7 +161,12 @@ int main(int argc, char* argv[])
 
         juego_actualizar(&juego);
         juego_renderizar(&juego);
-        SDL_Delay(LOOP_DELAY);
+        rendimiento_terminar(juego.rendimiento, FASE_CUADRO);
+
+        // El monitor toma los tiempos del cuadro, que luego se descartan
+        monitor_registrar_cuadro(juego.monitor, juego.rendimiento);
+        rendimiento_limpiar(juego.rendimiento);
+        juego_esperar_eventos(&juego);
     }
 
     juego_destruir(&juego);
@@ -1,11 +1,14 @@
 #include "memoria.h"
+#include "graficos.h"
 #include "imagenes.h"
 #include "vector.h"
 #include "sonidos.h"
+#include "recursos.h"
+#include "cargador.h"
+#include "arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 /* ---- Constantes ---- */
 #define TIEMPO_MOSTRAR_MS  700
@@ -15,6 +18,11 @@
 #define MARGEN_SUPERIOR    80
 #define BORDE_CARTA        4
 #define OPACIDAD_CARTA    100
+#define FILAS_X_TRAMO       32   /* Filas del atlas que se suben a la GPU por vez */
+#define PRESUPUESTO_CARGA_MS 4   /* Tiempo por cuadro dedicado a subir el atlas */
+#define INTERVALO_CARGA_MS  16   /* Refresco de la barra de progreso */
+#define SONIDOS_TABLERO      3
+#define TAM_ARENA_PARTIDA  (16 * 1024)  /* Alcanza para un tablero de 4x5; si no, la arena crece sola */
 
 /* Rutas de imágenes */
 static const char *RUTAS_SET1[] = {
@@ -33,14 +41,46 @@ static const char *RUTAS_SET2[] = {
 };
 #define TOTAL_SET2 10
 
+/* Efectos de la partida, en el orden de _sonido_tablero */
+static const char *RUTAS_SONIDOS[SONIDOS_TABLERO] = {
+    "snd/Acierto_parejas.mp3",
+    "snd/No_acierto.mp3",
+    "snd/Seleccion_primera.mp3"
+};
+
+/* Voces y prioridad de cada efecto: los clics rápidos no tapan el resultado de la jugada */
+static const int32_t VOCES_SONIDOS[SONIDOS_TABLERO] = { 2, 2, 3 };
+static const tPrioridadSnd PRIORIDAD_SONIDOS[SONIDOS_TABLERO] = {
+    PRIORIDAD_ALTA, PRIORIDAD_NORMAL, PRIORIDAD_BAJA
+};
+
+/* Notas (Hz) del destello de racha: sube por la escala pentatónica con cada acierto seguido */
+static const float NOTAS_RACHA[] = { 523.25f, 587.33f, 659.25f, 783.99f, 880.00f, 1046.50f };
+#define CANT_NOTAS_RACHA (int)(sizeof(NOTAS_RACHA) / sizeof(NOTAS_RACHA[0]))
+
 /* ---- Tipos internos ---- */
+
+/* Caras pre-renderizadas de cada pareja. El dorso es común a todas. */
+typedef enum {
+    CARA_FRENTE,
+    CARA_FRENTE_HOVER,
+    CARA_ENCONTRADA,
+    CARAS_X_PAREJA
+} tCaraCarta;
+
+/* Cartas del tablero como arreglos paralelos, indexados por la posición en la
+   grilla. Todo vive en un solo bloque: recorrer el tablero es leer memoria contigua. */
+#define BITS_X_PALABRA 32
+#define PALABRAS_BITS(n) (((n) + BITS_X_PALABRA - 1) / BITS_X_PALABRA)
+
 typedef struct {
-    int  idPareja;
-    int  indiceTextura;
-    int  puntos;
-    uint8_t descubierta;
-    uint8_t encontrada;
-} tCarta;
+    int *idPareja;
+    int *indiceTextura;
+    int *puntos;
+    uint32_t *descubiertas;    /* Un bit por carta */
+    uint32_t *encontradas;
+    size_t cantidad;
+} tCartas;
 
 typedef struct {
     int puntos;
@@ -49,11 +89,54 @@ typedef struct {
     int racha;
 } tEstadisticasJug;
 
+/* Atlas compartido de un set: se guarda en la cache de recursos y se reutiliza entre partidas */
+typedef struct {
+    SDL_Texture *textura;
+    SDL_Surface *lienzo;       /* Atlas en RAM mientras se sube por tramos; luego NULL */
+    tVector *regiones;         /* Vector de SDL_Rect: logos 0..pares-1 y el dorso al final */
+} tAtlasSet;
+
+typedef struct {
+    SDL_Renderer *renderer;    /* Solo para subir la textura: el hilo de carga no lo usa */
+    int setFiguras;
+    int pares;
+    int32_t anchoMax;          /* Tamaño máximo de textura del renderer */
+    int32_t altoMax;
+} tParametrosAtlas;
+
+/* Carga diferida: el hilo de carga decodifica y el hilo principal sube el
+   atlas a la GPU de a tramos, sin congelar la ventana. */
+typedef struct {
+    tCargador *cargador;
+    tParametrosAtlas paramAtlas;   /* Contexto de la tarea del atlas */
+    char claveAtlas[64];
+    int tareaAtlas;                /* -1 si el atlas ya estaba en la cache */
+    int tareaSonido[SONIDOS_TABLERO];
+    tAtlasSet *atlas;              /* Retirado del cargador, con la textura a medio subir */
+    int32_t filaSubida;
+} tCargaMemoria;
+
 struct sMemoria {
-    tVector *cartas;           /* Vector de tCarta* (punteros) */
-    tVector *texturas;         /* Vector de SDL_Texture* */
+    tArena *arena;             /* Donde vive toda la partida, incluida esta estructura */
+    tCartas cartas;
+    tVector *regiones;         /* Vector de SDL_Rect: región de cada pareja en el atlas */
     tVector *estadisticas;     /* Vector de tEstadisticasJug* */
+    tVector *layout;           /* Vector de SDL_Rect: posición de cada carta en pantalla */
+    tGrilla grilla;            /* Mismo layout, para resolver el hit-test en O(1) */
+    int anchoLayout;           /* Tamaño de salida para el que se calculó el layout */
+    int altoLayout;
+    tAtlasSet *atlasSet;       /* Referencia al atlas compartido (ver recursos_soltar) */
+    SDL_Texture *atlas;        /* Logos del set y dorso en una sola textura */
+    SDL_Rect regionReverso;    /* Región del dorso en el atlas (w == 0 si no hay) */
+    tVector *texturas;         /* Sin atlas: vector de SDL_Texture*, una por pareja */
     SDL_Texture *texturaReverso;
+    tLoteGeometria *loteFondo;  /* Geometría debajo de logos y dorsos */
+    tLoteGeometria *loteFrente; /* Bordes, hover y resaltados encima de ellos */
+    tVector *caras;            /* Vector de SDL_Texture*: CARAS_X_PAREJA por pareja */
+    SDL_Texture *caraDorso;
+    SDL_Texture *caraDorsoHover;
+    int anchoCaras;            /* Tamaño con el que se hornearon las caras */
+    int altoCaras;
     int filas;
     int columnas;
     int setFiguras;
@@ -68,6 +151,8 @@ struct sMemoria {
     tSonido *sonidoFallo;
     tSonido *sonidoPrimera;
     int cartaHover;
+    uint32_t cambios;          /* MEMORIA_CAMBIO_* pendientes de consumir */
+    tCargaMemoria *carga;      /* Carga diferida en curso, o NULL */
 };
 
 /* ---- Helpers ---- */
@@ -76,8 +161,7 @@ static int _rand_entre(int a, int b)
     return a + rand() % (b - a + 1);
 }
 
-static SDL_Texture* _crear_textura_color(SDL_Renderer *renderer, SDL_Color color,
-                                         int ancho, int alto)
+static SDL_Surface* _crear_superficie_color(SDL_Color color, int ancho, int alto)
 {
     SDL_Surface *sup = SDL_CreateRGBSurface(0, ancho, alto, 32,
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
@@ -104,64 +188,686 @@ static SDL_Texture* _crear_textura_color(SDL_Renderer *renderer, SDL_Color color
         SDL_FillRect(sup, &linea, blanco);
     }
 
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, sup);
-    SDL_FreeSurface(sup);
-    return tex;
+    return sup;
+}
+
+/* ---- Cartas ---- */
+
+static int _cartas_crear(tCartas *c, size_t cantidad, tArena *arena)
+{
+    size_t palabras = PALABRAS_BITS(cantidad);
+    size_t bytes = cantidad * 3 * sizeof(int) + palabras * 2 * sizeof(uint32_t);
+    void *bloque = arena_reservar(arena, bytes);
+    if (!bloque) return -1;
+    memset(bloque, 0, bytes);
+
+    /* Primero los bits: uint32_t no exige más alineación que int */
+    c->descubiertas  = (uint32_t*)bloque;
+    c->encontradas   = c->descubiertas + palabras;
+    c->idPareja      = (int*)(c->encontradas + palabras);
+    c->indiceTextura = c->idPareja + cantidad;
+    c->puntos        = c->indiceTextura + cantidad;
+    c->cantidad      = cantidad;
+    return 0;
 }
 
-static void _calcular_rect_carta(tMemoria *m, int indice, SDL_Rect *dst,
-                                 int anchoV, int altoV)
+static int _bit(const uint32_t *bits, size_t i)
 {
-    int col  = indice % m->columnas;
-    int fila = indice / m->columnas;
+    return (bits[i / BITS_X_PALABRA] >> (i % BITS_X_PALABRA)) & 1u;
+}
+
+static void _poner_bit(uint32_t *bits, size_t i, int valor)
+{
+    uint32_t mascara = 1u << (i % BITS_X_PALABRA);
+    if (valor) bits[i / BITS_X_PALABRA] |= mascara;
+    else       bits[i / BITS_X_PALABRA] &= ~mascara;
+}
+
+/* Intercambia dos cartas completas (para mezclar). */
+static void _cartas_intercambiar(tCartas *c, size_t i, size_t j)
+{
+    int tmp;
+    tmp = c->idPareja[i];      c->idPareja[i] = c->idPareja[j];           c->idPareja[j] = tmp;
+    tmp = c->indiceTextura[i]; c->indiceTextura[i] = c->indiceTextura[j]; c->indiceTextura[j] = tmp;
+    tmp = c->puntos[i];        c->puntos[i] = c->puntos[j];               c->puntos[j] = tmp;
+
+    int di = _bit(c->descubiertas, i), ei = _bit(c->encontradas, i);
+    _poner_bit(c->descubiertas, i, _bit(c->descubiertas, j));
+    _poner_bit(c->encontradas, i, _bit(c->encontradas, j));
+    _poner_bit(c->descubiertas, j, di);
+    _poner_bit(c->encontradas, j, ei);
+}
+
+/* Recalcula la posición de todas las cartas. Solo hace trabajo si cambió el
+   tamaño de salida respecto del último cálculo. */
+static int _actualizar_layout(tMemoria *m, int anchoV, int altoV)
+{
+    if (vector_size(m->layout) == (size_t)(m->filas * m->columnas) &&
+        anchoV == m->anchoLayout && altoV == m->altoLayout) {
+        return 0;
+    }
+
     int pad  = 8;
     int areaW = anchoV - pad * 2;
     int areaH = altoV - MARGEN_SUPERIOR - pad * 2;
     int w = areaW / m->columnas - pad;
     int h = areaH / m->filas    - pad;
-    dst->x = pad + col  * (w + pad);
-    dst->y = MARGEN_SUPERIOR + pad + fila * (h + pad);
-    dst->w = w;
-    dst->h = h;
+
+    m->grilla = (tGrilla){ pad, MARGEN_SUPERIOR + pad, w, h, w + pad, h + pad,
+                           m->columnas, m->filas };
+
+    vector_clear(m->layout);
+    if (vector_reserve(m->layout, (size_t)(m->filas * m->columnas)) != 0) return -1;
+
+    for (int fila = 0; fila < m->filas; ++fila) {
+        for (int col = 0; col < m->columnas; ++col) {
+            SDL_Rect dst = {
+                pad + col * (w + pad),
+                MARGEN_SUPERIOR + pad + fila * (h + pad),
+                w,
+                h
+            };
+            vector_push_back(m->layout, &dst);
+        }
+    }
+
+    m->anchoLayout = anchoV;
+    m->altoLayout  = altoV;
+    return 0;
 }
 
-static void _dibujar_borde_carta(SDL_Renderer *renderer, const SDL_Rect *rect, int encontrada)
+static const SDL_Rect* _rect_carta(tMemoria *m, size_t indice)
 {
-    if (encontrada) {
-        SDL_SetRenderDrawColor(renderer, 0, 200, 0, 255);
-    } else {
-        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-    }
+    return (const SDL_Rect*)vector_get(m->layout, indice);
+}
 
-    for (int i = 0; i < BORDE_CARTA; ++i) {
-        SDL_Rect borde = { rect->x + i, rect->y + i,
-                          rect->w - i*2, rect->h - i*2 };
-        SDL_RenderDrawRect(renderer, &borde);
-    }
+/* Devuelve la carta bajo el punto (mx, my), o -1 si no hay ninguna. */
+static int _carta_en_punto(tMemoria *m, int mx, int my)
+{
+    int indice = graficos_grilla_indice(&m->grilla, mx, my);
+    return (indice >= 0 && (size_t)indice < m->cartas.cantidad) ? indice : -1;
+}
+
+static void _agregar_borde_carta(tLoteGeometria *lote, const SDL_Rect *rect, int encontrada)
+{
+    SDL_Color colorBorde = encontrada ? (SDL_Color){0, 200, 0, 255} : (SDL_Color){40, 40, 40, 255};
+    graficos_lote_borde(lote, rect, BORDE_CARTA, colorBorde);
 
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 200);
     SDL_Rect bordeInt = {
         rect->x + BORDE_CARTA + 2,
         rect->y + BORDE_CARTA + 2,
         rect->w - (BORDE_CARTA + 2) * 2,
         rect->h - (BORDE_CARTA + 2) * 2
     };
-    SDL_RenderDrawRect(renderer, &bordeInt);
+    graficos_lote_borde(lote, &bordeInt, 1, (SDL_Color){200, 200, 200, 200});
 }
 
-/* ---- Funciones públicas ---- */
+/* Rectángulo centrado dentro de dst cuyo lado es 'porcentaje' del menor lado de dst. */
+static SDL_Rect _rect_centrado(const SDL_Rect *dst, int porcentaje)
+{
+    int lado = (dst->w < dst->h ? dst->w : dst->h) * porcentaje / 100;
+    SDL_Rect r = { dst->x + (dst->w - lado) / 2, dst->y + (dst->h - lado) / 2, lado, lado };
+    return r;
+}
 
-tMemoria* memoria_crear(SDL_Renderer *renderer, int filas, int columnas,
-                        int setFiguras, int usarSonidos, int cantJugadores)
+/* Acumula en los lotes la geometría de una carta dibujada en dst. */
+static void _acumular_carta(tMemoria *m, const SDL_Rect *dst, int visible,
+                            int encontrada, int hover)
+{
+    if (visible) {
+        graficos_lote_rect(m->loteFondo, dst, (SDL_Color){250, 250, 250, OPACIDAD_CARTA});
+        _agregar_borde_carta(m->loteFrente, dst, encontrada);
+        if (encontrada)
+            graficos_lote_rect(m->loteFrente, dst, (SDL_Color){0, 200, 0, 40});
+    } else {
+        graficos_lote_rect(m->loteFondo, dst, (SDL_Color){200, 200, 200, OPACIDAD_CARTA});
+        if (m->regionReverso.w == 0) {
+            SDL_Rect interior = { dst->x + 15, dst->y + 15, dst->w - 30, dst->h - 30 };
+            graficos_lote_rect(m->loteFondo, &interior, (SDL_Color){100, 120, 140, 100});
+        }
+        _agregar_borde_carta(m->loteFrente, dst, 0);
+    }
+
+    if (hover && !encontrada) {
+        graficos_lote_rect(m->loteFrente, dst, (SDL_Color){255, 255, 0, 60});
+        graficos_lote_borde(m->loteFrente, dst, 3, (SDL_Color){255, 255, 0, 255});
+    }
+}
+
+/* Copia desde el atlas (o desde su textura suelta si no hubo atlas) el logo
+   (carta visible) o el dorso de una carta. */
+static void _copiar_imagen_carta(tMemoria *m, SDL_Renderer *renderer, const SDL_Rect *dst,
+                                 int indiceTextura, int visible)
+{
+    if (visible) {
+        SDL_Rect logoRect = _rect_centrado(dst, 60);
+        SDL_Rect *region = (SDL_Rect*)vector_get(m->regiones, indiceTextura);
+        SDL_Texture **pt = (SDL_Texture**)vector_get(m->texturas, indiceTextura);
+        if (m->atlas && region) SDL_RenderCopy(renderer, m->atlas, region, &logoRect);
+        else if (pt && *pt)     SDL_RenderCopy(renderer, *pt, NULL, &logoRect);
+    } else if (m->atlas && m->regionReverso.w > 0) {
+        SDL_Rect dorsoRect = _rect_centrado(dst, 70);
+        SDL_RenderCopy(renderer, m->atlas, &m->regionReverso, &dorsoRect);
+    } else if (m->texturaReverso) {
+        SDL_Rect dorsoRect = _rect_centrado(dst, 70);
+        SDL_RenderCopy(renderer, m->texturaReverso, NULL, &dorsoRect);
+    }
+}
+
+static void _destruir_caras(tMemoria *m)
+{
+    for (size_t i = 0; i < vector_size(m->caras); ++i) {
+        SDL_Texture **pt = (SDL_Texture**)vector_get(m->caras, i);
+        if (*pt) SDL_DestroyTexture(*pt);
+    }
+    vector_clear(m->caras);
+    if (m->caraDorso) SDL_DestroyTexture(m->caraDorso);
+    if (m->caraDorsoHover) SDL_DestroyTexture(m->caraDorsoHover);
+    m->caraDorso = NULL;
+    m->caraDorsoHover = NULL;
+}
+
+/* Dibuja una vez una carta completa en su propia textura. */
+static SDL_Texture* _hornear_cara(tMemoria *m, SDL_Renderer *renderer, int indiceTextura,
+                                  int visible, int encontrada, int hover)
+{
+    SDL_Texture *cara = graficos_crear_lienzo(renderer, m->anchoCaras, m->altoCaras);
+    if (!cara) return NULL;
+
+    /* Sin mezcla premultiplicada la cara se vería con el alfa aplicado dos veces */
+    if (!graficos_lienzo_premultiplicado(cara)) {
+        SDL_DestroyTexture(cara);
+        return NULL;
+    }
+
+    SDL_Rect dst = { 0, 0, m->anchoCaras, m->altoCaras };
+    graficos_cambiar_framebuffer(renderer, cara);
+    graficos_borrar_pantalla(renderer, &(SDL_Color){0, 0, 0, 0});
+    _acumular_carta(m, &dst, visible, encontrada, hover);
+    graficos_lote_enviar(renderer, m->loteFondo);
+    _copiar_imagen_carta(m, renderer, &dst, indiceTextura, visible);
+    graficos_lote_enviar(renderer, m->loteFrente);
+    return cara;
+}
+
+/* Rehace las caras si cambió el tamaño de las cartas. Devuelve 0 si quedaron
+   listas para usarse, o -1 si hay que dibujar el tablero sin ellas. */
+static int _actualizar_caras(tMemoria *m, SDL_Renderer *renderer)
+{
+    if (m->anchoCaras == m->grilla.anchoCelda && m->altoCaras == m->grilla.altoCelda)
+        return m->caraDorso ? 0 : -1;
+
+    _destruir_caras(m);
+    m->anchoCaras = m->grilla.anchoCelda;
+    m->altoCaras  = m->grilla.altoCelda;
+    if (m->anchoCaras <= 0 || m->altoCaras <= 0) return -1;
+
+    SDL_Texture *targetPrevio = SDL_GetRenderTarget(renderer);
+    int ok = 1;
+
+    size_t pares = m->cartas.cantidad / 2;
+    for (size_t id = 0; ok && id < pares; ++id) {
+        SDL_Texture *cara[CARAS_X_PAREJA] = {
+            _hornear_cara(m, renderer, (int)id, 1, 0, 0),
+            _hornear_cara(m, renderer, (int)id, 1, 0, 1),
+            _hornear_cara(m, renderer, (int)id, 1, 1, 0),
+        };
+        for (int e = 0; e < CARAS_X_PAREJA; ++e) {
+            if (!cara[e] || vector_push_back(m->caras, &cara[e]) != 0) {
+                if (cara[e]) SDL_DestroyTexture(cara[e]);
+                ok = 0;
+            }
+        }
+    }
+
+    if (ok) {
+        m->caraDorso      = _hornear_cara(m, renderer, 0, 0, 0, 0);
+        m->caraDorsoHover = _hornear_cara(m, renderer, 0, 0, 0, 1);
+        ok = m->caraDorso && m->caraDorsoHover;
+    }
+
+    graficos_cambiar_framebuffer(renderer, targetPrevio);
+
+    if (!ok) {
+        _destruir_caras(m);
+        return -1;
+    }
+    return 0;
+}
+
+/* Camino sin caras pre-renderizadas: dos lotes de geometría y una copia por carta. */
+static void _dibujar_tablero_directo(tMemoria *m, SDL_Renderer *renderer)
+{
+    const tCartas *c = &m->cartas;
+    for (size_t i = 0; i < c->cantidad; ++i) {
+        int encontrada = _bit(c->encontradas, i);
+        _acumular_carta(m, _rect_carta(m, i), encontrada || _bit(c->descubiertas, i),
+                        encontrada, (int)i == m->cartaHover);
+    }
+
+    graficos_lote_enviar(renderer, m->loteFondo);
+
+    for (size_t i = 0; i < c->cantidad; ++i) {
+        _copiar_imagen_carta(m, renderer, _rect_carta(m, i), c->indiceTextura[i],
+                             _bit(c->encontradas, i) || _bit(c->descubiertas, i));
+    }
+
+    graficos_lote_enviar(renderer, m->loteFrente);
+}
+
+/* Logo de una pareja del set, o la imagen generada si no hay archivo. */
+static SDL_Surface* _superficie_logo(int setFiguras, int id)
+{
+    SDL_Surface *sup = NULL;
+    if (setFiguras == 1 && id < TOTAL_SET1) {
+        sup = imagenes_cargar_ram(RUTAS_SET1[id]);
+    }
+    if (setFiguras == 2 && id < TOTAL_SET2) {
+        sup = imagenes_cargar_ram(RUTAS_SET2[id]);
+    }
+    if (!sup) {
+        SDL_Color fb = { (uint8_t)(50+id*20), (uint8_t)(100+id*15),
+                         (uint8_t)(200-id*15), 255 };
+        sup = _crear_superficie_color(fb, TAM_CARTA_GEN, TAM_CARTA_GEN);
+    }
+    return sup;
+}
+
+static SDL_Surface* _superficie_dorso(int setFiguras)
+{
+    const char *rutaDorso = NULL;
+    if (setFiguras == 1){
+        rutaDorso = "img/dorso_lpf.png";
+    } else if (setFiguras == 2){
+        rutaDorso = "img/dorso_champions.png";
+    }
+    return rutaDorso ? imagenes_cargar_ram(rutaDorso) : NULL;
+}
+
+/* Decodifica los logos de un set y el dorso al final, y los empaqueta en un
+   atlas en RAM. No usa el renderer: corre también en el hilo de carga (tDecodificar). */
+static void* _decodificar_atlas(void *contexto)
+{
+    const tParametrosAtlas *p = (const tParametrosAtlas*)contexto;
+    int pares = p->pares;
+
+    tAtlasSet *set = malloc(sizeof(tAtlasSet));
+    if (!set) return NULL;
+    set->textura = NULL;
+    set->lienzo = NULL;
+    set->regiones = vector_create(sizeof(SDL_Rect));
+
+    /* Decodificar una superficie por pareja y el dorso al final */
+    tVector *superficies = vector_create(sizeof(SDL_Surface*));
+    if (!superficies || !set->regiones) {
+        vector_destroy(superficies);
+        vector_destroy(set->regiones);
+        free(set);
+        return NULL;
+    }
+
+    for (int id = 0; id < pares; ++id) {
+        SDL_Surface *sup = _superficie_logo(p->setFiguras, id);
+        if (!sup || vector_push_back(superficies, &sup) != 0) {
+            if (sup) SDL_FreeSurface(sup);
+            break;
+        }
+    }
+
+    SDL_Surface *supDorso = _superficie_dorso(p->setFiguras);
+    if (vector_push_back(superficies, &supDorso) != 0 && supDorso) SDL_FreeSurface(supDorso);
+
+    /* Empaquetar todo en el atlas: regiones 0..pares-1 logos, la última el dorso */
+    size_t cantSup = vector_size(superficies);
+    if (cantSup == (size_t)pares + 1 && vector_resize(set->regiones, cantSup) == 0) {
+        set->lienzo = imagenes_empaquetar_atlas((SDL_Surface* const*)superficies->data, cantSup,
+                                                (SDL_Rect*)set->regiones->data,
+                                                p->anchoMax, p->altoMax);
+    }
+
+    for (size_t i = 0; i < cantSup; ++i) {
+        SDL_Surface **ps = (SDL_Surface**)vector_get(superficies, i);
+        if (*ps) SDL_FreeSurface(*ps);
+    }
+    vector_destroy(superficies);
+
+    if (!set->lienzo) {
+        vector_destroy(set->regiones);
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+/* Libera un atlas desalojado de la cache o descartado por el cargador (tLiberarRecurso). */
+static void _liberar_atlas(void *recurso)
+{
+    tAtlasSet *set = (tAtlasSet*)recurso;
+    if (set->textura) SDL_DestroyTexture(set->textura);
+    if (set->lienzo) SDL_FreeSurface(set->lienzo);
+    vector_destroy(set->regiones);
+    free(set);
+}
+
+/* Carga el atlas de un set de una sola vez, en el hilo principal (tCargarRecurso). */
+static void* _cargar_atlas(void *contexto)
+{
+    const tParametrosAtlas *p = (const tParametrosAtlas*)contexto;
+    tAtlasSet *set = (tAtlasSet*)_decodificar_atlas(contexto);
+    if (!set) return NULL;
+
+    set->textura = SDL_CreateTextureFromSurface(p->renderer, set->lienzo);
+    SDL_FreeSurface(set->lienzo);
+    set->lienzo = NULL;
+
+    if (!set->textura) {
+        fprintf(stderr, "Error: No se pudo crear la textura del atlas: %s\n", SDL_GetError());
+        _liberar_atlas(set);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(set->textura, SDL_BLENDMODE_BLEND);
+    return set;
+}
+
+static void* _decodificar_sonido(void *contexto)
+{
+    return sonidos_cargar((const char*)contexto);
+}
+
+static void _descartar_sonido(void *resultado)
+{
+    sonidos_destruir((tSonido*)resultado);
+}
+
+/* Campo de la partida que guarda el efecto RUTAS_SONIDOS[i]. */
+static tSonido** _sonido_tablero(tMemoria *m, int i)
+{
+    tSonido **sonidos[SONIDOS_TABLERO] = { &m->sonidoAcierto, &m->sonidoFallo, &m->sonidoPrimera };
+    return sonidos[i];
+}
+
+/* Guarda el efecto RUTAS_SONIDOS[i] en la partida con sus límites de voces. */
+static void _asignar_sonido(tMemoria *m, int i, tSonido *sonido)
+{
+    *_sonido_tablero(m, i) = sonido;
+    sonidos_configurar_voces(sonido, VOCES_SONIDOS[i], PRIORIDAD_SONIDOS[i]);
+}
+
+/* Destello sintetizado que acompaña al acierto a partir del segundo seguido. */
+static void _sonar_racha(int racha)
+{
+    int nota = racha - 2;
+    if (nota < 0) return;
+    if (nota >= CANT_NOTAS_RACHA) nota = CANT_NOTAS_RACHA - 1;
+
+    tEfectoSinte destello = { ONDA_CUADRADA, NOTAS_RACHA[nota], NOTAS_RACHA[nota] * 1.5f,
+                              4, 40, 60, 90, 0.4f, 0.3f };
+    sonidos_sintetizar(&destello);
+}
+
+static void _clave_atlas(int setFiguras, int pares, char *clave, size_t tamClave)
+{
+    snprintf(clave, tamClave, "atlas:set=%d:pares=%d", setFiguras, pares);
+}
+
+static void _parametros_atlas(tMemoria *m, tParametrosAtlas *p, char *clave, size_t tamClave)
+{
+    SDL_RendererInfo info;
+    memset(p, 0, sizeof(tParametrosAtlas));
+    p->renderer   = m->renderer;
+    p->setFiguras = m->setFiguras;
+    p->pares      = (m->filas * m->columnas) / 2;
+    if (SDL_GetRendererInfo(m->renderer, &info) == 0) {
+        p->anchoMax = info.max_texture_width;
+        p->altoMax  = info.max_texture_height;
+    }
+    _clave_atlas(p->setFiguras, p->pares, clave, tamClave);
+}
+
+/* Toma las regiones del atlas compartido ya cargado en m->atlasSet. */
+static int _usar_atlas(tMemoria *m)
+{
+    int pares = (m->filas * m->columnas) / 2;
+
+    /* Copia propia de las regiones: 0..pares-1 logos, el dorso aparte */
+    vector_clear(m->regiones);
+    if (vector_push_range(m->regiones, m->atlasSet->regiones->data, (size_t)pares) != 0)
+        return -1;
+    m->regionReverso = *(SDL_Rect*)vector_get(m->atlasSet->regiones, (size_t)pares);
+    m->atlas = m->atlasSet->textura;
+    return 0;
+}
+
+static SDL_Texture* _textura_de_superficie(SDL_Renderer *renderer, SDL_Surface *sup)
+{
+    if (!sup) return NULL;
+    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, sup);
+    SDL_FreeSurface(sup);
+    return tex;
+}
+
+/* Sin atlas (p. ej. si no entra en el tamaño máximo de textura) se carga,
+   como antes, una textura por pareja y otra para el dorso. */
+static int _cargar_texturas_sueltas(tMemoria *m)
+{
+    int pares = (m->filas * m->columnas) / 2;
+    for (int id = (int)vector_size(m->texturas); id < pares; ++id) {
+        SDL_Texture *tex = _textura_de_superficie(m->renderer, _superficie_logo(m->setFiguras, id));
+        if (vector_push_back(m->texturas, &tex) != 0) {
+            if (tex) SDL_DestroyTexture(tex);
+            return -1;
+        }
+    }
+    if (!m->texturaReverso)
+        m->texturaReverso = _textura_de_superficie(m->renderer, _superficie_dorso(m->setFiguras));
+    return 0;
+}
+
+static void _destruir_texturas_sueltas(tMemoria *m)
+{
+    for (size_t i = 0; i < vector_size(m->texturas); ++i) {
+        SDL_Texture **pt = (SDL_Texture**)vector_get(m->texturas, i);
+        if (*pt) SDL_DestroyTexture(*pt);
+    }
+    vector_clear(m->texturas);
+    if (m->texturaReverso) SDL_DestroyTexture(m->texturaReverso);
+    m->texturaReverso = NULL;
+}
+
+/* Completa en el hilo principal el atlas y los efectos que falten. */
+static int _cargar_recursos(tMemoria *m)
+{
+    if (!m->atlas && vector_size(m->texturas) == 0) {
+        tParametrosAtlas paramAtlas;
+        char claveAtlas[64];
+        _parametros_atlas(m, &paramAtlas, claveAtlas, sizeof(claveAtlas));
+
+        /* El atlas del set se decodifica una sola vez y queda en la cache de recursos */
+        if (!m->atlasSet)
+            m->atlasSet = (tAtlasSet*)recursos_obtener(claveAtlas, _cargar_atlas, _liberar_atlas, &paramAtlas);
+        if (!m->atlasSet || _usar_atlas(m) != 0) {
+            fprintf(stderr, "Aviso: sin atlas para el set %d, se usa una textura por pareja\n", m->setFiguras);
+            recursos_soltar(m->atlasSet);
+            m->atlasSet = NULL;
+            if (_cargar_texturas_sueltas(m) != 0) return -1;
+        }
+    }
+
+    for (int i = 0; m->usarSonidos && i < SONIDOS_TABLERO; ++i) {
+        if (!*_sonido_tablero(m, i)) _asignar_sonido(m, i, recursos_sonido(RUTAS_SONIDOS[i]));
+    }
+    return 0;
+}
+
+static void _cancelar_carga(tMemoria *m)
+{
+    if (!m->carga) return;
+    cargador_destruir(m->carga->cargador);
+    if (m->carga->atlas) _liberar_atlas(m->carga->atlas);
+    free(m->carga);
+    m->carga = NULL;
+}
+
+/* Pide al hilo de carga lo que no esté en la cache. Retorna 0 si no hay
+   nada que cargar o el hilo quedó trabajando, -1 si no se pudo lanzar. */
+static int _iniciar_carga(tMemoria *m)
+{
+    tCargaMemoria *c = malloc(sizeof(tCargaMemoria));
+    if (!c) return -1;
+    memset(c, 0, sizeof(tCargaMemoria));
+    m->carga = c;
+
+    c->cargador = cargador_crear();
+    if (!c->cargador) {
+        _cancelar_carga(m);
+        return -1;
+    }
+
+    _parametros_atlas(m, &c->paramAtlas, c->claveAtlas, sizeof(c->claveAtlas));
+    c->tareaAtlas = -1;
+    m->atlasSet = (tAtlasSet*)recursos_buscar(c->claveAtlas);
+    if (m->atlasSet) {
+        if (_usar_atlas(m) != 0) {
+            _cancelar_carga(m);
+            return -1;
+        }
+    } else {
+        c->tareaAtlas = cargador_agregar(c->cargador, _decodificar_atlas, _liberar_atlas, &c->paramAtlas);
+        if (c->tareaAtlas < 0) {
+            _cancelar_carga(m);
+            return -1;
+        }
+    }
+
+    int pendientes = (c->tareaAtlas >= 0);
+    for (int i = 0; i < SONIDOS_TABLERO; ++i) {
+        c->tareaSonido[i] = -1;
+        if (!m->usarSonidos) continue;
+        _asignar_sonido(m, i, recursos_buscar_sonido(RUTAS_SONIDOS[i]));
+        if (!*_sonido_tablero(m, i)) {
+            c->tareaSonido[i] = cargador_agregar(c->cargador, _decodificar_sonido, _descartar_sonido,
+                                                 (void*)RUTAS_SONIDOS[i]);
+            if (c->tareaSonido[i] >= 0) pendientes++;
+        }
+    }
+
+    /* Todo estaba en la cache: no hace falta el hilo */
+    if (!pendientes) {
+        _cancelar_carga(m);
+        return 0;
+    }
+
+    if (cargador_iniciar(c->cargador) != TODO_OK) {
+        _cancelar_carga(m);
+        return -1;
+    }
+    return 0;
+}
+
+/* Abandona la carga diferida y completa lo que falte de una sola vez en el
+   hilo principal. Si ni así se puede, el tablero se dibuja sin imágenes. */
+static void _reintentar_carga(tMemoria *m)
+{
+    _cancelar_carga(m);
+    if (_cargar_recursos(m) != 0)
+        fprintf(stderr, "Error: No se pudieron cargar las imágenes del tablero\n");
+}
+
+/* Avanza la carga diferida: retira lo decodificado y sube el atlas a la GPU
+   sin pasar de PRESUPUESTO_CARGA_MS por llamada. */
+static void _continuar_carga(tMemoria *m)
+{
+    tCargaMemoria *c = m->carga;
+    m->cambios |= MEMORIA_CAMBIO_TABLERO;   /* Redibuja la barra de progreso */
+    if (!cargador_listo(c->cargador)) return;
+
+    if (c->tareaAtlas >= 0 && !m->atlasSet) {
+        if (!c->atlas) {
+            c->atlas = (tAtlasSet*)cargador_retirar(c->cargador, c->tareaAtlas);
+            if (c->atlas) c->atlas->textura = imagenes_crear_textura_tramos(m->renderer, c->atlas->lienzo);
+            if (!c->atlas || !c->atlas->textura) {
+                _reintentar_carga(m);
+                return;
+            }
+        }
+
+        uint32_t inicio = SDL_GetTicks();
+        SDL_Surface *lienzo = c->atlas->lienzo;
+        while (c->filaSubida >= 0 && c->filaSubida < lienzo->h &&
+               SDL_GetTicks() - inicio < PRESUPUESTO_CARGA_MS) {
+            c->filaSubida = imagenes_subir_tramo(c->atlas->textura, lienzo, c->filaSubida, FILAS_X_TRAMO);
+        }
+        if (c->filaSubida < 0) {
+            _reintentar_carga(m);
+            return;
+        }
+        if (c->filaSubida < lienzo->h) return;
+
+        SDL_FreeSurface(lienzo);
+        c->atlas->lienzo = NULL;
+        m->atlasSet = (tAtlasSet*)recursos_adoptar(c->claveAtlas, c->atlas, _liberar_atlas);
+        c->atlas = NULL;
+        if (!m->atlasSet || _usar_atlas(m) != 0) {
+            _reintentar_carga(m);
+            return;
+        }
+    }
+
+    for (int i = 0; i < SONIDOS_TABLERO; ++i) {
+        if (c->tareaSonido[i] < 0) continue;
+        tSonido *sonido = (tSonido*)cargador_retirar(c->cargador, c->tareaSonido[i]);
+        _asignar_sonido(m, i, recursos_adoptar_sonido(RUTAS_SONIDOS[i], sonido));
+    }
+
+    _cancelar_carga(m);
+}
+
+/* Barra de progreso mientras se cargan los recursos del tablero. */
+static void _dibujar_progreso(tMemoria *m, SDL_Renderer *renderer)
+{
+    float progreso = memoria_progreso_carga(m);
+    SDL_Rect marco = { m->anchoLayout / 5, m->altoLayout / 2 - 12, (m->anchoLayout * 3) / 5, 24 };
+    SDL_Rect barra = { marco.x + BORDE_CARTA, marco.y + BORDE_CARTA,
+                       (int)((marco.w - 2*BORDE_CARTA) * progreso), marco.h - 2*BORDE_CARTA };
+
+    graficos_lote_rect(m->loteFondo, &marco, (SDL_Color){40, 40, 40, 200});
+    graficos_lote_rect(m->loteFondo, &barra, (SDL_Color){100, 255, 100, 255});
+    graficos_lote_borde(m->loteFondo, &marco, 2, (SDL_Color){250, 250, 250, 255});
+    graficos_lote_enviar(renderer, m->loteFondo);
+}
+
+/* Arena de la última partida destruida, ya reiniciada: la siguiente la reutiliza
+   sin volver a pedir memoria al sistema. */
+static tArena *arenaLibre = NULL;
+
+static void _devolver_arena(tArena *arena)
+{
+    arena_reiniciar(arena);
+    if (!arenaLibre) arenaLibre = arena;
+    else             arena_destruir(arena);
+}
+
+/* Crea la partida sin atlas ni efectos: cartas mezcladas, layout y estadísticas. */
+static tMemoria* _crear_tablero(SDL_Renderer *renderer, int filas, int columnas,
+                                int setFiguras, int usarSonidos, int cantJugadores)
 {
     if (!renderer || filas <= 0 || columnas <= 0) return NULL;
     int total = filas * columnas;
     if (total % 2 != 0) return NULL;
     int pares = total / 2;
 
-    tMemoria *m = malloc(sizeof(tMemoria));
-    if (!m) return NULL;
+    /* Todo lo propio de la partida sale de una sola arena */
+    tArena *arena = arenaLibre ? arenaLibre : arena_crear(TAM_ARENA_PARTIDA);
+    arenaLibre = NULL;
+    if (!arena) return NULL;
+
+    tMemoria *m = arena_reservar(arena, sizeof(tMemoria));
+    if (!m) {
+        _devolver_arena(arena);
+        return NULL;
+    }
     memset(m, 0, sizeof(tMemoria));
+    m->arena = arena;
 
     m->filas        = filas;
     m->columnas     = columnas;
@@ -170,22 +876,32 @@ tMemoria* memoria_crear(SDL_Renderer *renderer, int filas, int columnas,
     m->cantJugadores = (cantJugadores >= 2) ? 2 : 1;
     m->turnoActual  = 0;
 
-    /* Crear vectores dinámicos */
-    m->cartas = vector_create(sizeof(tCarta*));
-    m->texturas = vector_create(sizeof(SDL_Texture*));
-    m->estadisticas = vector_create(sizeof(tEstadisticasJug*));
-    
-    if (!m->cartas || !m->texturas || !m->estadisticas) {
-        if (m->cartas) vector_destroy(m->cartas);
-        if (m->texturas) vector_destroy(m->texturas);
-        if (m->estadisticas) vector_destroy(m->estadisticas);
-        free(m);
+    /* Crear vectores dinámicos dentro de la arena */
+    tAllocator asignador = arena_asignador(arena);
+    m->regiones = vector_create_with(sizeof(SDL_Rect), &asignador);
+    m->estadisticas = vector_create_with(sizeof(tEstadisticasJug*), &asignador);
+    m->layout = vector_create_with(sizeof(SDL_Rect), &asignador);
+    m->caras = vector_create_with(sizeof(SDL_Texture*), &asignador);
+    m->texturas = vector_create_with(sizeof(SDL_Texture*), &asignador);
+    m->loteFondo = graficos_lote_crear();
+    m->loteFrente = graficos_lote_crear();
+
+    if (_cartas_crear(&m->cartas, (size_t)total, arena) != 0 || !m->regiones || !m->estadisticas || !m->layout || !m->caras || !m->texturas ||
+        !m->loteFondo || !m->loteFrente) {
+        memoria_destruir(m);
+        return NULL;
+    }
+
+    int anchoV, altoV;
+    SDL_GetRendererOutputSize(renderer, &anchoV, &altoV);
+    if (_actualizar_layout(m, anchoV, altoV) != 0) {
+        memoria_destruir(m);
         return NULL;
     }
 
     /* Inicializar estadísticas para cada jugador */
     for (int j = 0; j < m->cantJugadores; ++j) {
-        tEstadisticasJug *est = malloc(sizeof(tEstadisticasJug));
+        tEstadisticasJug *est = arena_reservar(arena, sizeof(tEstadisticasJug));
         if (!est) {
             memoria_destruir(m);
             return NULL;
@@ -194,166 +910,147 @@ tMemoria* memoria_crear(SDL_Renderer *renderer, int filas, int columnas,
         vector_push_back(m->estadisticas, &est);
     }
 
-    const char *rutaDorso = NULL;
-    if (setFiguras == 1){
-        rutaDorso = "img/dorso_lpf.png";
-    } else if (setFiguras == 2){
-        rutaDorso = "img/dorso_champions.png";
-    }
-
-    if (rutaDorso) m->texturaReverso = imagenes_cargar_gpu(renderer, rutaDorso);
-
-    srand((unsigned)time(NULL));
-
-    /* Cargar texturas (una por pareja) */
+    /* Crear dos cartas por pareja (los bits ya quedaron en cero) */
+    tCartas *c = &m->cartas;
     for (int id = 0; id < pares; ++id) {
-        SDL_Texture *tex = NULL;
-        if (setFiguras == 1 && id < TOTAL_SET1) {
-            tex = imagenes_cargar_gpu(renderer, RUTAS_SET1[id]);
-        }
-        if (setFiguras == 2 && id < TOTAL_SET2) {
-            tex = imagenes_cargar_gpu(renderer, RUTAS_SET2[id]);
-        }
-        if (!tex) {
-            SDL_Color fb = { (uint8_t)(50+id*20), (uint8_t)(100+id*15),
-                             (uint8_t)(200-id*15), 255 };
-            tex = _crear_textura_color(renderer, fb, TAM_CARTA_GEN, TAM_CARTA_GEN);
-        }
-        if (!tex) {
-            memoria_destruir(m);
-            return NULL;
-        }
-        vector_push_back(m->texturas, &tex);
-
-        /* Crear dos cartas por pareja */
         int puntosPareja = _rand_entre(PUNTOS_MIN, PUNTOS_MAX);
         for (int rep = 0; rep < 2; ++rep) {
-            tCarta *carta = malloc(sizeof(tCarta));
-            if (!carta) {
-                memoria_destruir(m);
-                return NULL;
-            }
-            carta->idPareja      = id;
-            carta->indiceTextura = id;
-            carta->puntos        = puntosPareja;
-            carta->descubierta   = 0;
-            carta->encontrada    = 0;
-            vector_push_back(m->cartas, &carta);
+            size_t i = (size_t)id * 2 + rep;
+            c->idPareja[i]      = id;
+            c->indiceTextura[i] = id;
+            c->puntos[i]        = puntosPareja;
         }
     }
 
     /* Mezclar cartas (Fisher-Yates) */
-    size_t n = vector_size(m->cartas);
-    for (size_t i = n - 1; i > 0; --i) {
+    for (size_t i = c->cantidad - 1; i > 0; --i) {
         size_t j = rand() % (i + 1);
-        if (i != j) {
-            tCarta **ci = (tCarta**)vector_get(m->cartas, i);
-            tCarta **cj = (tCarta**)vector_get(m->cartas, j);
-            tCarta *tmp = *ci;
-            *ci = *cj;
-            *cj = tmp;
-        }
+        if (i != j) _cartas_intercambiar(c, i, j);
     }
 
     m->seleccionado1 = -1;
     m->seleccionado2 = -1;
     m->tiempoEspera  = 0;
     m->cartaHover    = -1;
+    m->cambios       = MEMORIA_CAMBIO_TABLERO | MEMORIA_CAMBIO_ESTADISTICAS;
 
     m->usarSonidos   = usarSonidos;
     m->sonidoAcierto = NULL;
     m->sonidoFallo   = NULL;
     m->sonidoPrimera = NULL;
-    if (usarSonidos) {
-        m->sonidoAcierto = sonidos_cargar("snd/Acierto_parejas.mp3");
-        m->sonidoFallo   = sonidos_cargar("snd/No_acierto.mp3");
-        m->sonidoPrimera = sonidos_cargar("snd/Seleccion_primera.mp3");
-    }
     return m;
 }
 
-void memoria_destruir(tMemoria *m)
+/* ---- Funciones públicas ---- */
+
+tMemoria* memoria_crear(SDL_Renderer *renderer, int filas, int columnas,
+                        int setFiguras, int usarSonidos, int cantJugadores)
 {
-    if (!m) return;
+    tMemoria *m = _crear_tablero(renderer, filas, columnas, setFiguras, usarSonidos, cantJugadores);
+    if (!m) return NULL;
 
-    /* Destruir cartas */
-    if (m->cartas) {
-        for (size_t i = 0; i < vector_size(m->cartas); ++i) {
-            tCarta **pc = (tCarta**)vector_get(m->cartas, i);
-            if (pc && *pc) free(*pc);
-        }
-        vector_destroy(m->cartas);
+    if (_cargar_recursos(m) != 0) {
+        memoria_destruir(m);
+        return NULL;
     }
+    return m;
+}
 
-    /* Destruir texturas */
-    if (m->texturas) {
-        for (size_t i = 0; i < vector_size(m->texturas); ++i) {
-            SDL_Texture **pt = (SDL_Texture**)vector_get(m->texturas, i);
-            if (pt && *pt) SDL_DestroyTexture(*pt);
-        }
-        vector_destroy(m->texturas);
+tMemoria* memoria_crear_diferida(SDL_Renderer *renderer, int filas, int columnas,
+                                 int setFiguras, int usarSonidos, int cantJugadores)
+{
+    tMemoria *m = _crear_tablero(renderer, filas, columnas, setFiguras, usarSonidos, cantJugadores);
+    if (!m) return NULL;
+
+    /* Sin hilo de carga se cae a la carga en el hilo principal */
+    if (_iniciar_carga(m) != 0 && _cargar_recursos(m) != 0) {
+        memoria_destruir(m);
+        return NULL;
     }
+    return m;
+}
 
-    /* Destruir estadísticas */
-    if (m->estadisticas) {
-        for (size_t i = 0; i < vector_size(m->estadisticas); ++i) {
-            tEstadisticasJug **pe = (tEstadisticasJug**)vector_get(m->estadisticas, i);
-            if (pe && *pe) free(*pe);
-        }
-        vector_destroy(m->estadisticas);
+int memoria_cargando(tMemoria *m)
+{
+    return m && m->carga;
+}
+
+float memoria_progreso_carga(tMemoria *m)
+{
+    if (!m || !m->carga) return 1.0f;
+
+    /* La decodificación pesa la mitad y la subida del atlas la otra mitad */
+    tCargaMemoria *c = m->carga;
+    float subida = 1.0f;
+    if (c->tareaAtlas >= 0 && !m->atlasSet) {
+        subida = (c->atlas && c->atlas->lienzo)
+                 ? (float)c->filaSubida / (float)c->atlas->lienzo->h : 0.0f;
     }
+    return 0.5f * cargador_progreso(c->cargador) + 0.5f * subida;
+}
 
-    if (m->texturaReverso) SDL_DestroyTexture(m->texturaReverso);
-    if (m->sonidoAcierto) sonidos_destruir(m->sonidoAcierto);
-    if (m->sonidoFallo)   sonidos_destruir(m->sonidoFallo);
-    if (m->sonidoPrimera) sonidos_destruir(m->sonidoPrimera);
-    free(m);
+void memoria_destruir(tMemoria *m)
+{
+    if (!m) return;
+
+    _cancelar_carga(m);
+
+    /* Solo se libera lo que no está en la arena: texturas, lotes y recursos compartidos */
+    recursos_soltar(m->atlasSet);
+    if (m->caras) _destruir_caras(m);
+    if (m->texturas) _destruir_texturas_sueltas(m);
+
+    graficos_lote_destruir(m->loteFondo);
+    graficos_lote_destruir(m->loteFrente);
+    recursos_soltar(m->sonidoAcierto);
+    recursos_soltar(m->sonidoFallo);
+    recursos_soltar(m->sonidoPrimera);
+
+    /* Cartas, vectores, estadísticas y la propia partida se descartan juntos */
+    _devolver_arena(m->arena);
+}
+
+void memoria_desalojar_atlas(int filas, int columnas, int setFiguras)
+{
+    char clave[64];
+    _clave_atlas(setFiguras, (filas * columnas) / 2, clave, sizeof(clave));
+    recursos_desalojar_clave(clave);
+}
+
+void memoria_finalizar(void)
+{
+    arena_destruir(arenaLibre);
+    arenaLibre = NULL;
 }
 
 tError memoria_procesar_evento(tMemoria *m, const SDL_Event *ev)
 {
     if (!m || !ev) return ERR_MEMORIA;
-
-    int anchoV, altoV;
-    SDL_GetRendererOutputSize(m->renderer, &anchoV, &altoV);
+    if (m->carga) return TODO_OK;
 
     if (ev->type == SDL_MOUSEMOTION) {
-        int mx = ev->motion.x, my = ev->motion.y;
-        m->cartaHover = -1;
-        for (size_t i = 0; i < vector_size(m->cartas); ++i) {
-            SDL_Rect dst;
-            _calcular_rect_carta(m, (int)i, &dst, anchoV, altoV);
-            if (mx >= dst.x && mx <= dst.x+dst.w && my >= dst.y && my <= dst.y+dst.h) {
-                tCarta **pc = (tCarta**)vector_get(m->cartas, i);
-                if (pc && *pc && !(*pc)->encontrada) m->cartaHover = (int)i;
-                break;
-            }
-        }
+        int hoverPrevio = m->cartaHover;
+        int i = _carta_en_punto(m, ev->motion.x, ev->motion.y);
+        m->cartaHover = (i >= 0 && !_bit(m->cartas.encontradas, (size_t)i)) ? i : -1;
+        if (m->cartaHover != hoverPrevio) m->cambios |= MEMORIA_CAMBIO_TABLERO;
     }
 
     if (ev->type == SDL_MOUSEBUTTONDOWN && ev->button.button == SDL_BUTTON_LEFT) {
-        int mx = ev->button.x, my = ev->button.y;
-        for (size_t i = 0; i < vector_size(m->cartas); ++i) {
-            SDL_Rect dst;
-            _calcular_rect_carta(m, (int)i, &dst, anchoV, altoV);
-            if (mx >= dst.x && mx <= dst.x+dst.w && my >= dst.y && my <= dst.y+dst.h) {
-                tCarta **pc = (tCarta**)vector_get(m->cartas, i);
-                if (!pc || !*pc) break;
-                tCarta *c = *pc;
-                if (c->encontrada || c->descubierta) break;
-                if (m->seleccionado2 != -1 && m->tiempoEspera > 0) break;
-
-                if (m->seleccionado1 == -1) {
-                    c->descubierta = 1;
-                    m->seleccionado1 = (int)i;
-                    if (m->usarSonidos && m->sonidoPrimera) sonidos_reproducir(m->sonidoPrimera, 1);
-                } else if (m->seleccionado1 != (int)i) {
-                    c->descubierta = 1;
-                    m->seleccionado2 = (int)i;
-                    m->tiempoEspera  = TIEMPO_MOSTRAR_MS;
-                }
-                break;
-            }
+        int i = _carta_en_punto(m, ev->button.x, ev->button.y);
+        if (i < 0) return TODO_OK;
+        if (_bit(m->cartas.encontradas, (size_t)i) || _bit(m->cartas.descubiertas, (size_t)i)) return TODO_OK;
+        if (m->seleccionado2 != -1 && m->tiempoEspera > 0) return TODO_OK;
+
+        if (m->seleccionado1 == -1) {
+            _poner_bit(m->cartas.descubiertas, (size_t)i, 1);
+            m->seleccionado1 = i;
+            m->cambios |= MEMORIA_CAMBIO_TABLERO;
+            if (m->usarSonidos && m->sonidoPrimera) sonidos_reproducir(m->sonidoPrimera, 1);
+        } else if (m->seleccionado1 != i) {
+            _poner_bit(m->cartas.descubiertas, (size_t)i, 1);
+            m->seleccionado2 = i;
+            m->tiempoEspera  = TIEMPO_MOSTRAR_MS;
+            m->cambios |= MEMORIA_CAMBIO_TABLERO;
         }
     }
     return TODO_OK;
@@ -362,16 +1059,17 @@ tError memoria_procesar_evento(tMemoria *m, const SDL_Event *ev)
 void memoria_actualizar(tMemoria *m, uint32_t deltaMs)
 {
     if (!m) return;
+    if (m->carga) {
+        _continuar_carga(m);
+        return;
+    }
     if (m->seleccionado2 == -1 || m->tiempoEspera == 0) return;
 
     if (deltaMs >= m->tiempoEspera) {
-        tCarta **pc1 = (tCarta**)vector_get(m->cartas, m->seleccionado1);
-        tCarta **pc2 = (tCarta**)vector_get(m->cartas, m->seleccionado2);
-        
-        if (!pc1 || !*pc1 || !pc2 || !*pc2) return;
-        
-        tCarta *c1 = *pc1;
-        tCarta *c2 = *pc2;
+        tCartas *c = &m->cartas;
+        size_t c1 = (size_t)m->seleccionado1;
+        size_t c2 = (size_t)m->seleccionado2;
+        if (c1 >= c->cantidad || c2 >= c->cantidad) return;
         
         tEstadisticasJug **pest = (tEstadisticasJug**)vector_get(m->estadisticas, m->turnoActual);
         if (!pest || !*pest) return;
@@ -379,18 +1077,20 @@ void memoria_actualizar(tMemoria *m, uint32_t deltaMs)
         
         est->intentos++;
 
-        if (c1->idPareja == c2->idPareja) {
-            c1->encontrada = 1;
-            c2->encontrada = 1;
+        if (c->idPareja[c1] == c->idPareja[c2]) {
+            _poner_bit(c->encontradas, c1, 1);
+            _poner_bit(c->encontradas, c2, 1);
             est->aciertos++;
             est->racha++;
             float mult = 1.0f + 0.25f * (est->racha - 1);
-            est->puntos += (int)(c1->puntos * mult + 0.5f);
+            est->puntos += (int)(c->puntos[c1] * mult + 0.5f);
             if (m->usarSonidos && m->sonidoAcierto)
                 sonidos_reproducir(m->sonidoAcierto, 1);
+            if (m->usarSonidos)
+                _sonar_racha(est->racha);
         } else {
-            c1->descubierta = 0;
-            c2->descubierta = 0;
+            _poner_bit(c->descubiertas, c1, 0);
+            _poner_bit(c->descubiertas, c2, 0);
             est->racha = 0;
             if (m->usarSonidos && m->sonidoFallo)
                 sonidos_reproducir(m->sonidoFallo, 1);
@@ -400,6 +1100,7 @@ void memoria_actualizar(tMemoria *m, uint32_t deltaMs)
         m->seleccionado1 = -1;
         m->seleccionado2 = -1;
         m->tiempoEspera  = 0;
+        m->cambios |= MEMORIA_CAMBIO_TABLERO | MEMORIA_CAMBIO_ESTADISTICAS;
     } else {
         m->tiempoEspera -= deltaMs;
     }
@@ -408,73 +1109,32 @@ void memoria_actualizar(tMemoria *m, uint32_t deltaMs)
 void memoria_renderizar(tMemoria *m, SDL_Renderer *renderer)
 {
     if (!m || !renderer) return;
-    int anchoV, altoV;
-    SDL_GetRendererOutputSize(renderer, &anchoV, &altoV);
 
-    for (size_t i = 0; i < vector_size(m->cartas); ++i) {
-        tCarta **pc = (tCarta**)vector_get(m->cartas, i);
-        if (!pc || !*pc) continue;
-        tCarta *c = *pc;
-        
-        SDL_Rect dst;
-        _calcular_rect_carta(m, (int)i, &dst, anchoV, altoV);
-
-        if (c->descubierta || c->encontrada) {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, 250, 250, 250, OPACIDAD_CARTA);
-            SDL_RenderFillRect(renderer, &dst);
-
-            int logoSize = (dst.w < dst.h ? dst.w : dst.h) * 60 / 100;
-            SDL_Rect logoRect = {
-                dst.x + (dst.w - logoSize) / 2,
-                dst.y + (dst.h - logoSize) / 2,
-                logoSize,
-                logoSize
-            };
-
-            SDL_Texture **pt = (SDL_Texture**)vector_get(m->texturas, c->indiceTextura);
-            if (pt && *pt) SDL_RenderCopy(renderer, *pt, NULL, &logoRect);
-
-            _dibujar_borde_carta(renderer, &dst, c->encontrada);
+    if (m->carga) {
+        _dibujar_progreso(m, renderer);
+        return;
+    }
 
-            if (c->encontrada) {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 0, 200, 0, 40);
-                SDL_RenderFillRect(renderer, &dst);
-            }
-        } else {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, 200, 200, 200, OPACIDAD_CARTA);
-            SDL_RenderFillRect(renderer, &dst);
-
-            if (m->texturaReverso){
-                int dorsoSize = (dst.w < dst.h ? dst.w : dst.h) * 70 / 100;
-                SDL_Rect dorsoRect = {
-                    dst.x + (dst.w - dorsoSize) / 2,
-                    dst.y + (dst.h - dorsoSize) / 2,
-                    dorsoSize,
-                    dorsoSize
-                };
-                SDL_RenderCopy(renderer, m->texturaReverso, NULL, &dorsoRect);
-            } else {
-                SDL_SetRenderDrawColor(renderer, 100, 120, 140, 100);
-                SDL_Rect interior = { dst.x + 15, dst.y + 15, dst.w - 30, dst.h - 30 };
-                SDL_RenderFillRect(renderer, &interior);
-            }
+    /* Sin una cara por pareja no se puede indexar: se dibuja carta por carta */
+    const tCartas *c = &m->cartas;
+    if (_actualizar_caras(m, renderer) != 0 || vector_size(m->caras) < (c->cantidad / 2) * CARAS_X_PAREJA) {
+        _dibujar_tablero_directo(m, renderer);
+        return;
+    }
 
-            _dibujar_borde_carta(renderer, &dst, 0);
-        }
+    /* Una sola copia por carta desde su cara ya dibujada */
+    SDL_Texture **caras = (SDL_Texture**)m->caras->data;
+    for (size_t i = 0; i < c->cantidad; ++i) {
+        int hover = ((int)i == m->cartaHover);
+        SDL_Texture *cara;
+        if (_bit(c->encontradas, i))
+            cara = caras[c->indiceTextura[i] * CARAS_X_PAREJA + CARA_ENCONTRADA];
+        else if (_bit(c->descubiertas, i))
+            cara = caras[c->indiceTextura[i] * CARAS_X_PAREJA + (hover ? CARA_FRENTE_HOVER : CARA_FRENTE)];
+        else
+            cara = hover ? m->caraDorsoHover : m->caraDorso;
 
-        if ((int)i == m->cartaHover && !c->encontrada) {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 60);
-            SDL_RenderFillRect(renderer, &dst);
-            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-            for (int b = 0; b < 3; ++b) {
-                SDL_Rect highlight = { dst.x + b, dst.y + b, dst.w - b*2, dst.h - b*2 };
-                SDL_RenderDrawRect(renderer, &highlight);
-            }
-        }
+        SDL_RenderCopy(renderer, cara, NULL, _rect_carta(m, i));
     }
 }
 
@@ -524,9 +1184,57 @@ int memoria_obtener_turno(tMemoria *m)
 int memoria_partida_terminada(tMemoria *m)
 {
     if (!m) return 1;
-    for (size_t i = 0; i < vector_size(m->cartas); ++i) {
-        tCarta **pc = (tCarta**)vector_get(m->cartas, i);
-        if (pc && *pc && !(*pc)->encontrada) return 0;
+    /* De a 32 cartas por vez: cada palabra debe tener todos sus bits en uno */
+    const tCartas *c = &m->cartas;
+    size_t completas = c->cantidad / BITS_X_PALABRA;
+    for (size_t w = 0; w < completas; ++w) {
+        if (c->encontradas[w] != UINT32_MAX) return 0;
     }
+    size_t resto = c->cantidad % BITS_X_PALABRA;
+    if (resto && c->encontradas[completas] != (1u << resto) - 1u) return 0;
     return 1;
-}
\ No newline at end of file
+}
+
+uint32_t memoria_consumir_cambios(tMemoria *m)
+{
+    if (!m) return 0;
+    uint32_t cambios = m->cambios;
+    m->cambios = 0;
+    return cambios;
+}
+
+void memoria_redimensionar(tMemoria *m, int anchoVentana, int altoVentana)
+{
+    if (!m) return;
+    if (_actualizar_layout(m, anchoVentana, altoVentana) == 0)
+        m->cambios |= MEMORIA_CAMBIO_TABLERO;
+}
+
+void memoria_invalidar_caras(tMemoria *m)
+{
+    if (!m) return;
+    m->anchoCaras = 0;
+    m->altoCaras  = 0;
+    m->cambios |= MEMORIA_CAMBIO_TABLERO;
+}
+
+int32_t memoria_proximo_cambio_ms(tMemoria *m)
+{
+    if (m && m->carga) return INTERVALO_CARGA_MS;
+    if (!m || m->seleccionado2 == -1 || m->tiempoEspera == 0) return -1;
+    return (int32_t)m->tiempoEspera;
+}
+
+int memoria_cantidad_cartas(tMemoria *m)
+{
+    return m ? (int)m->cartas.cantidad : 0;
+}
+
+int memoria_obtener_rect_carta(tMemoria *m, int indice, SDL_Rect *rect)
+{
+    if (!m || !rect || indice < 0) return -1;
+    const SDL_Rect *r = _rect_carta(m, (size_t)indice);
+    if (!r) return -1;
+    *rect = *r;
+    return 0;
+}
@@ -8,18 +8,56 @@
 /* Estructura opaca que contiene el estado completo de una partida. */
 typedef struct sMemoria tMemoria;
 
+/* Cambios visibles que informa memoria_consumir_cambios. */
+#define MEMORIA_CAMBIO_TABLERO       0x01  /* volteo, hover o pareja resuelta */
+#define MEMORIA_CAMBIO_ESTADISTICAS  0x02  /* puntos, aciertos, intentos o turno */
+
+/* Crea una partida. El mezclado usa rand(): quien llama fija la semilla. */
 tMemoria* memoria_crear(SDL_Renderer *renderer, int filas, int columnas,
                         int setFiguras, int usarSonidos, int cantJugadores);
 
+/* Igual que memoria_crear, pero los logos y efectos que no estén en la cache
+   se decodifican en un hilo aparte y el atlas se sube a la GPU de a tramos
+   desde memoria_actualizar. Mientras tanto la partida ignora los eventos y
+   memoria_renderizar dibuja una barra de progreso. */
+tMemoria* memoria_crear_diferida(SDL_Renderer *renderer, int filas, int columnas,
+                                 int setFiguras, int usarSonidos, int cantJugadores);
+
+/* Devuelve 1 mientras la carga diferida no terminó. */
+int memoria_cargando(tMemoria *m);
+
+/* Progreso de la carga diferida, entre 0 y 1 (1 si no hay carga en curso). */
+float memoria_progreso_carga(tMemoria *m);
+
 /* Libera todos los recursos de la partida. */
 void memoria_destruir(tMemoria *m);
 
+/* Saca de la cache el atlas de un tablero que ya no se va a jugar. Los sonidos
+   y el resto de los recursos siguen cargados para la próxima partida. */
+void memoria_desalojar_atlas(int filas, int columnas, int setFiguras);
+
+/* Libera la memoria que se guarda para la próxima partida. Va al cerrar el juego. */
+void memoria_finalizar(void);
+
 /* Procesa un evento SDL (clic y movimiento de mouse). */
 tError memoria_procesar_evento(tMemoria *m, const SDL_Event *ev);
 
 /* Actualiza la lógica (retardo tras segunda selección). */
 void memoria_actualizar(tMemoria *m, uint32_t deltaMs);
 
+/* Recalcula la posición de las cartas para un nuevo tamaño de ventana.
+   El layout se calcula una sola vez y solo se invalida desde aquí. */
+void memoria_redimensionar(tMemoria *m, int anchoVentana, int altoVentana);
+
+/* Obliga a rehornear las caras de las cartas en el próximo dibujo. Va cuando
+   el driver descartó el contenido de las texturas target. */
+void memoria_invalidar_caras(tMemoria *m);
+
+/* Milisegundos hasta que la partida cambie por sí sola (fin del retardo
+   tras la segunda selección o próximo paso de la carga diferida), o -1 si
+   solo puede cambiar por un evento. */
+int32_t memoria_proximo_cambio_ms(tMemoria *m);
+
 /* Renderiza el tablero de cartas. */
 void memoria_renderizar(tMemoria *m, SDL_Renderer *renderer);
 
@@ -38,4 +76,15 @@ int memoria_obtener_turno(tMemoria *m);
 /* Devuelve 1 si todas las parejas fueron encontradas. */
 int memoria_partida_terminada(tMemoria *m);
 
+/* Devuelve los cambios (MEMORIA_CAMBIO_*) acumulados desde la última
+   llamada y los reinicia. Una partida recién creada informa todos. */
+uint32_t memoria_consumir_cambios(tMemoria *m);
+
+/* Cantidad de cartas del tablero. */
+int memoria_cantidad_cartas(tMemoria *m);
+
+/* Copia en rect la posición en pantalla de una carta. Retorna 0 si OK,
+   -1 si el índice no existe. */
+int memoria_obtener_rect_carta(tMemoria *m, int indice, SDL_Rect *rect);
+
 #endif // MEMORIA_H_INCLUDED
@@ -1,8 +1,10 @@
 #include "menu.h"
+#include "graficos.h"
 #include "imagenes.h"
 #include "ranking.h"
 #include "texto.h"
 #include "presentacion.h"
+#include "recursos.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -24,28 +26,26 @@ static void _dibujar_opcion(SDL_Renderer *renderer, TTF_Font *fuente, tOpcionMen
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderDrawRect(renderer, &op->rect);
 
-    SDL_Texture *tex = texto_crear_textura(renderer, fuente, op->texto,
-                                           (SDL_Color){255,255,255,255});
-    if (tex) {
-        int w, h;
-        SDL_QueryTexture(tex, NULL, NULL, &w, &h);
-        if (w > op->rect.w - 8) w = op->rect.w - 8;
-        if (h > op->rect.h - 4) h = op->rect.h - 4;
-        SDL_Rect dst = {
-            op->rect.x + (op->rect.w - w) / 2,
-            op->rect.y + (op->rect.h - h) / 2,
-            w, h
-        };
-        SDL_RenderCopy(renderer, tex, NULL, &dst);
-        SDL_DestroyTexture(tex);
-    }
+    /* Un texto más largo que el botón se recorta dentro del borde */
+    SDL_Rect interior = { op->rect.x + 4, op->rect.y + 2, op->rect.w - 8, op->rect.h - 4 };
+    SDL_RenderSetClipRect(renderer, &interior);
+    texto_dibujar_centrado(renderer, fuente, op->texto, &op->rect,
+                           (SDL_Color){255,255,255,255});
+    SDL_RenderSetClipRect(renderer, NULL);
 }
 
-/* Devuelve 1 si (mx,my) está dentro de rect */
-static int _dentro(const SDL_Rect *r, int mx, int my)
+/* Grilla de una fila a partir de la primera y la segunda celda */
+static tGrilla _fila_de_botones(const SDL_Rect *primero, const SDL_Rect *segundo, int cantidad)
 {
-    return mx >= r->x && mx <= r->x + r->w &&
-           my >= r->y && my <= r->y + r->h;
+    tGrilla fila = { primero->x, primero->y, primero->w, primero->h,
+                     segundo->x - primero->x, primero->h, cantidad, 1 };
+    return fila;
+}
+
+/* Marca como seleccionada solo la opción 'elegida' del grupo */
+static void _seleccionar(tOpcionMenu *opciones, int cantidad, int elegida)
+{
+    for (int j = 0; j < cantidad; ++j) opciones[j].seleccionado = (j == elegida);
 }
 
 tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *fondoPath, 
@@ -54,7 +54,7 @@ tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *f
 {
     if (!renderer || !fuente || !cfg) return ACCION_SALIR;
 
-    SDL_Texture *fondoConfig = imagenes_cargar_gpu(renderer, "img/fondo_config.png");
+    SDL_Texture *fondoConfig = recursos_textura(renderer, "img/fondo_config.png");
 
     int anchoV, altoV;
     SDL_GetRendererOutputSize(renderer, &anchoV, &altoV);
@@ -97,34 +97,42 @@ tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *f
     setOpc[cfg->setFiguras == 2 ? 1 : 0].seleccionado = 1;
     jugOpc[cfg->cantJugadores == 2 ? 1 : 0].seleccionado = 1;
 
+    /* Índice de hit-test: una grilla por fila de botones */
+    tGrilla filaDim     = _fila_de_botones(&dimOpc[0].rect, &dimOpc[1].rect, 3);
+    tGrilla filaSet     = _fila_de_botones(&setOpc[0].rect, &setOpc[1].rect, 2);
+    tGrilla filaJug     = _fila_de_botones(&jugOpc[0].rect, &jugOpc[1].rect, 2);
+    tGrilla filaBotones = _fila_de_botones(&botonJugar, &botonScores, 3);
+
     /* ---- Loop del menú ---- */
+    /* El menú solo cambia con la entrada del usuario: se dibuja una vez y
+       después se bloquea hasta el próximo evento en lugar de redibujar cada 16 ms. */
+    int redibujar = 1;
     while (1) {
         SDL_Event ev;
+        if (!redibujar) SDL_WaitEvent(NULL);
         while (SDL_PollEvent(&ev)) {
             if (ev.type == SDL_QUIT) {
-                if (fondoConfig) SDL_DestroyTexture(fondoConfig);
+                recursos_soltar(fondoConfig);
                 return ACCION_SALIR;
             }
+            if (ev.type == SDL_WINDOWEVENT) {
+                redibujar = 1;
+            }
             if (ev.type == SDL_MOUSEBUTTONDOWN && ev.button.button == SDL_BUTTON_LEFT) {
+                redibujar = 1;
                 int mx = ev.button.x, my = ev.button.y;
+                int i;
 
-                for (int i = 0; i < 3; ++i)
-                    if (_dentro(&dimOpc[i].rect, mx, my)) {
-                        for (int j = 0; j < 3; ++j) dimOpc[j].seleccionado = 0;
-                        dimOpc[i].seleccionado = 1;
-                    }
-                for (int i = 0; i < 2; ++i)
-                    if (_dentro(&setOpc[i].rect, mx, my)) {
-                        for (int j = 0; j < 2; ++j) setOpc[j].seleccionado = 0;
-                        setOpc[i].seleccionado = 1;
-                    }
-                for (int i = 0; i < 2; ++i)
-                    if (_dentro(&jugOpc[i].rect, mx, my)) {
-                        for (int j = 0; j < 2; ++j) jugOpc[j].seleccionado = 0;
-                        jugOpc[i].seleccionado = 1;
-                    }
-
-                if (_dentro(&botonJugar, mx, my)) {
+                if ((i = graficos_grilla_indice(&filaDim, mx, my)) >= 0) {
+                    _seleccionar(dimOpc, 3, i);
+                }
+                else if ((i = graficos_grilla_indice(&filaSet, mx, my)) >= 0) {
+                    _seleccionar(setOpc, 2, i);
+                }
+                else if ((i = graficos_grilla_indice(&filaJug, mx, my)) >= 0) {
+                    _seleccionar(jugOpc, 2, i);
+                }
+                else if ((i = graficos_grilla_indice(&filaBotones, mx, my)) == 0) {
                     /* Aplicar selecciones */
                     if      (dimOpc[0].seleccionado) { cfg->filas = 3; cfg->columnas = 4; }
                     else if (dimOpc[1].seleccionado) { cfg->filas = 4; cfg->columnas = 4; }
@@ -133,22 +141,23 @@ tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *f
                     cfg->setFiguras   = setOpc[1].seleccionado ? 2 : 1;
                     cfg->cantJugadores = jugOpc[1].seleccionado ? 2 : 1;
 
-                    if (fondoConfig) SDL_DestroyTexture(fondoConfig);
+                    recursos_soltar(fondoConfig);
                     return ACCION_JUGAR;
                 }
-
-                if (_dentro(&botonScores, mx, my)) {
-                    if (fondoConfig) SDL_DestroyTexture(fondoConfig);
+                else if (i == 1) {
+                    recursos_soltar(fondoConfig);
                     return ACCION_VER_SCORES;
                 }
-
-                if (_dentro(&botonNombres, mx, my)) {
-                    if (fondoConfig) SDL_DestroyTexture(fondoConfig);
+                else if (i == 2) {
+                    recursos_soltar(fondoConfig);
                     return ACCION_CAMBIAR_NOMBRES;
                 }
             }
         }
 
+        if (!redibujar) continue;
+        redibujar = 0;
+
         /* ---- Render ---- */
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
@@ -158,27 +167,18 @@ tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *f
         }
 
         /* Título */
-        SDL_Texture *tTitulo = texto_crear_textura(renderer, fuente,
-            "MEMOTEST - FULBITO", (SDL_Color){255, 255, 100, 255});
-        if (tTitulo) {
-            int w, h; SDL_QueryTexture(tTitulo, NULL, NULL, &w, &h);
-            SDL_Rect dst = { centroX - w/2, 30, w, h };
-            SDL_RenderCopy(renderer, tTitulo, NULL, &dst);
-            SDL_DestroyTexture(tTitulo);
-        }
+        int w;
+        texto_medir(renderer, fuente, "MEMOTEST - FULBITO", &w, NULL);
+        texto_dibujar(renderer, fuente, "MEMOTEST - FULBITO", centroX - w/2, 30,
+                      (SDL_Color){255, 255, 100, 255});
 
         /* Etiquetas */
         const char *etiquetas[] = { "Dimensiones:", "Set de figuras:", "Jugadores:" };
         int etiquetasY[]        = { dimY - 40, setY - 40, jugY - 40 };
         for (int i = 0; i < 3; ++i) {
-            SDL_Texture *tLbl = texto_crear_textura(renderer, fuente,
-                etiquetas[i], (SDL_Color){255,255,255,255});
-            if (tLbl) {
-                int w, h; SDL_QueryTexture(tLbl, NULL, NULL, &w, &h);
-                SDL_Rect dst = { centroX - w/2, etiquetasY[i], w, h };
-                SDL_RenderCopy(renderer, tLbl, NULL, &dst);
-                SDL_DestroyTexture(tLbl);
-            }
+            texto_medir(renderer, fuente, etiquetas[i], &w, NULL);
+            texto_dibujar(renderer, fuente, etiquetas[i], centroX - w/2, etiquetasY[i],
+                          (SDL_Color){255,255,255,255});
         }
 
         /* Opciones */
@@ -195,55 +195,32 @@ tAccionMenu menu_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *f
         } else {
             snprintf(infoNombres, sizeof(infoNombres), "Sin nombres configurados");
         }
-        SDL_Texture *tInfo = texto_crear_textura(renderer, fuente, infoNombres, (SDL_Color){255, 255, 100, 255});
-        if (tInfo) {
-            int w, h; SDL_QueryTexture(tInfo, NULL, NULL, &w, &h);
-            SDL_Rect dst = { centroX - w/2, botonesY - 45, w, h };
-            SDL_RenderCopy(renderer, tInfo, NULL, &dst);
-            SDL_DestroyTexture(tInfo);
-        }
+        texto_medir(renderer, fuente, infoNombres, &w, NULL);
+        texto_dibujar(renderer, fuente, infoNombres, centroX - w/2, botonesY - 45,
+                      (SDL_Color){255, 255, 100, 255});
 
         /* Botón JUGAR */
         SDL_SetRenderDrawColor(renderer, 200, 60, 60, 255);
         SDL_RenderFillRect(renderer, &botonJugar);
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderDrawRect(renderer, &botonJugar);
-        SDL_Texture *tJugar = texto_crear_textura(renderer, fuente, "JUGAR", (SDL_Color){255,255,255,255});
-        if (tJugar) {
-            int w, h; SDL_QueryTexture(tJugar, NULL, NULL, &w, &h);
-            SDL_Rect dst = { botonJugar.x + (botonJugar.w-w)/2, botonJugar.y + (botonJugar.h-h)/2, w, h };
-            SDL_RenderCopy(renderer, tJugar, NULL, &dst);
-            SDL_DestroyTexture(tJugar);
-        }
+        texto_dibujar_centrado(renderer, fuente, "JUGAR", &botonJugar, (SDL_Color){255,255,255,255});
 
         /* Botón SCORES */
         SDL_SetRenderDrawColor(renderer, 60, 60, 200, 255);
         SDL_RenderFillRect(renderer, &botonScores);
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderDrawRect(renderer, &botonScores);
-        SDL_Texture *tScores = texto_crear_textura(renderer, fuente, "SCORES", (SDL_Color){255,255,255,255});
-        if (tScores) {
-            int w, h; SDL_QueryTexture(tScores, NULL, NULL, &w, &h);
-            SDL_Rect dst = { botonScores.x + (botonScores.w-w)/2, botonScores.y + (botonScores.h-h)/2, w, h };
-            SDL_RenderCopy(renderer, tScores, NULL, &dst);
-            SDL_DestroyTexture(tScores);
-        }
+        texto_dibujar_centrado(renderer, fuente, "SCORES", &botonScores, (SDL_Color){255,255,255,255});
 
         /* Botón CAMBIAR NOMBRES */
         SDL_SetRenderDrawColor(renderer, 60, 150, 60, 255);
         SDL_RenderFillRect(renderer, &botonNombres);
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderDrawRect(renderer, &botonNombres);
-        SDL_Texture *tNombres = texto_crear_textura(renderer, fuente, "NOMBRES", (SDL_Color){255,255,255,255});
-        if (tNombres) {
-            int w, h; SDL_QueryTexture(tNombres, NULL, NULL, &w, &h);
-            SDL_Rect dst = { botonNombres.x + (botonNombres.w-w)/2, botonNombres.y + (botonNombres.h-h)/2, w, h };
-            SDL_RenderCopy(renderer, tNombres, NULL, &dst);
-            SDL_DestroyTexture(tNombres);
-        }
+        texto_dibujar_centrado(renderer, fuente, "NOMBRES", &botonNombres, (SDL_Color){255,255,255,255});
 
         SDL_RenderPresent(renderer);
-        SDL_Delay(16);
     }
 }
 
@@ -251,25 +228,33 @@ void menu_mostrar_highscores(SDL_Renderer *renderer, TTF_Font *fuente, const cha
     tVector *ranking = ranking_cargar(RUTA_RANKING);
     if (!ranking) return;
 
-    SDL_Texture *fondo = imagenes_cargar_gpu(renderer, fondoPath);
+    SDL_Texture *fondo = recursos_textura(renderer, fondoPath);
 
     int anchoV, altoV;
     SDL_GetRendererOutputSize(renderer, &anchoV, &altoV);
 
     int salir = 0;
+    int redibujar = 1;
     while (!salir) {
         SDL_Event ev;
+        if (!redibujar) SDL_WaitEvent(NULL); /* Pantalla estática: esperar entrada */
         while (SDL_PollEvent(&ev)) {
             if (ev.type == SDL_QUIT) {
                 vector_destroy(ranking);
-                if (fondo) SDL_DestroyTexture(fondo);
+                recursos_soltar(fondo);
                 exit(0);
             }
             if (ev.type == SDL_KEYDOWN || ev.type == SDL_MOUSEBUTTONDOWN) {
                 salir = 1;
             }
+            if (ev.type == SDL_WINDOWEVENT) {
+                redibujar = 1;
+            }
         }
 
+        if (salir || !redibujar) continue;
+        redibujar = 0;
+
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
@@ -280,9 +265,8 @@ void menu_mostrar_highscores(SDL_Renderer *renderer, TTF_Font *fuente, const cha
         ranking_renderizar(renderer, fuente, fuente, ranking, anchoV, altoV);
 
         SDL_RenderPresent(renderer);
-        SDL_Delay(16);
     }
 
     vector_destroy(ranking);
-    if (fondo) SDL_DestroyTexture(fondo);
+    recursos_soltar(fondo);
 }
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "monitor.h"
+#include "hud.h"
+#include "texto.h"
+#include "graficos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUTA_FUENTE_MONITOR  "fnt/IBMPlexMono-Regular.ttf"
+#define TAM_FUENTE_MONITOR   14
+#define TAM_LINEA            64
+#define COLUMNAS_LINEA       34    // Caracteres de cada linea, completados con espacios
+#define INTERVALO_TEXTO_MS   250   // Cada cuanto se regeneran los textos
+#define HISTORIAL            120   // Cuadros visibles en el grafico
+#define ANCHO_BARRA          2
+#define ANCHO_GRAFICO        (HISTORIAL * ANCHO_BARRA)
+#define ALTO_GRAFICO         80
+#define MS_GRAFICO           33.4f // Dos presupuestos de 60 Hz
+#define PRESUPUESTO_MS       16.7f
+#define MARGEN               10
+#define ALTO_LINEA           18
+
+/* Fases que no se superponen entre si: apiladas suman el cuadro. */
+static const tFase FASES_GRAFICO[] = {
+    FASE_EVENTOS, FASE_ACTUALIZAR, FASE_CAPA_FONDO, FASE_CAPA_ESCENA, FASE_CAPA_HUD, FASE_PRESENTAR
+};
+#define CANT_FASES_GRAFICO ((int32_t)(sizeof(FASES_GRAFICO) / sizeof(FASES_GRAFICO[0])))
+
+static const SDL_Color COLORES_FASE[CANT_FASES_GRAFICO] = {
+    {255, 200,   0, 255}, // Eventos
+    {255, 100, 200, 255}, // Actualizar
+    { 80,  80, 255, 255}, // Capa fondo
+    { 60, 200, 255, 255}, // Capa escena
+    { 80, 255, 120, 255}, // Capa HUD
+    {255,  70,  70, 255}, // Presentar
+};
+
+/* Lineas de texto: FPS y una por fase. */
+enum { LINEA_FPS, LINEA_PRIMERA_FASE, CANT_LINEAS = LINEA_PRIMERA_FASE + CANT_FASES_GRAFICO };
+
+typedef struct {
+    SDL_Texture *lienzo;  // Propiedad del tHUD una vez devuelto
+    tLoteGeometria *lote;
+    float ms[HISTORIAL][CANT_FASES_GRAFICO];
+    int32_t pos;          // Proxima columna a escribir (la mas antigua)
+} tGrafico;
+
+struct sMonitor {
+    SDL_Renderer *renderer;
+    TTF_Font *fuente;
+    tHUD *lineas[CANT_LINEAS];
+    tHUD *grafico;
+    tGrafico *datosGrafico;
+    int32_t anchoLinea;   // Ancho en pixeles de una linea de COLUMNAS_LINEA caracteres
+    uint8_t visible;
+    uint8_t graficoPendiente;
+    // Acumulado del intervalo de texto en curso
+    uint32_t inicioIntervalo;
+    uint32_t cuadrosIntervalo;
+    uint32_t presentadosIntervalo;
+    double sumaCuadro;
+    double suma[CANT_FASES_GRAFICO];
+    double maximo[CANT_FASES_GRAFICO];
+};
+
+static SDL_Texture* _actualizar_linea(SDL_Renderer *renderer, void *dato, void *datoNuevo, void *extra)
+{
+    (void)dato;
+    return texto_crear_textura(renderer, (TTF_Font*)extra, (const char*)datoNuevo, (SDL_Color){255, 255, 255, 255});
+}
+
+static SDL_Texture* _actualizar_grafico(SDL_Renderer *renderer, void *dato, void *datoNuevo, void *extra)
+{
+    (void)dato;
+    (void)datoNuevo;
+    tGrafico *g = (tGrafico*)extra;
+
+    if (!g->lienzo) {
+        g->lienzo = graficos_crear_lienzo(renderer, ANCHO_GRAFICO, ALTO_GRAFICO);
+        if (!g->lienzo) {
+            return NULL;
+        }
+    }
+
+    const float pxPorMs = ALTO_GRAFICO / MS_GRAFICO;
+    graficos_lote_rect(g->lote, &(SDL_Rect){0, 0, ANCHO_GRAFICO, ALTO_GRAFICO}, (SDL_Color){0, 0, 0, 160});
+
+    for (int32_t col = 0; col < HISTORIAL; col++) {
+        const float *ms = g->ms[(g->pos + col) % HISTORIAL]; // De la mas antigua a la mas nueva
+        int32_t base = ALTO_GRAFICO;
+        for (int32_t f = 0; f < CANT_FASES_GRAFICO && base > 0; f++) {
+            int32_t alto = (int32_t)(ms[f] * pxPorMs + 0.5f);
+            if (alto > base) {
+                alto = base;
+            }
+            graficos_lote_rect(g->lote, &(SDL_Rect){col * ANCHO_BARRA, base - alto, ANCHO_BARRA, alto}, COLORES_FASE[f]);
+            base -= alto;
+        }
+    }
+
+    int32_t yPresupuesto = ALTO_GRAFICO - (int32_t)(PRESUPUESTO_MS * pxPorMs);
+    graficos_lote_rect(g->lote, &(SDL_Rect){0, yPresupuesto, ANCHO_GRAFICO, 1}, (SDL_Color){255, 255, 255, 180});
+
+    SDL_Texture *targetPrevio = SDL_GetRenderTarget(renderer);
+    graficos_cambiar_framebuffer(renderer, g->lienzo);
+    graficos_borrar_pantalla(renderer, &(SDL_Color){0, 0, 0, 0});
+    graficos_lote_enviar(renderer, g->lote);
+    graficos_cambiar_framebuffer(renderer, targetPrevio);
+
+    return g->lienzo;
+}
+
+static void _destruir_grafico(void *extra)
+{
+    tGrafico *g = (tGrafico*)extra;
+    graficos_lote_destruir(g->lote); // El lienzo lo libera el HUD junto con su textura
+    free(g);
+}
+
+tMonitor* monitor_crear(SDL_Renderer *renderer)
+{
+    tMonitor *monitor = calloc(1, sizeof(tMonitor));
+    if (!monitor) {
+        return NULL;
+    }
+    monitor->renderer = renderer;
+
+    monitor->fuente = texto_cargar_fuente(RUTA_FUENTE_MONITOR, TAM_FUENTE_MONITOR);
+    monitor->datosGrafico = calloc(1, sizeof(tGrafico));
+    if (monitor->datosGrafico) {
+        monitor->datosGrafico->lote = graficos_lote_crear();
+    }
+    if (!monitor->fuente || !monitor->datosGrafico || !monitor->datosGrafico->lote) {
+        monitor_destruir(monitor);
+        return NULL;
+    }
+
+    // tHUD se posiciona por el centro de su textura
+    monitor->grafico = hud_inicializar(renderer, MARGEN + ANCHO_GRAFICO / 2, MARGEN + ALTO_GRAFICO / 2,
+                                       NULL, 0, monitor->datosGrafico, _actualizar_grafico, _destruir_grafico);
+    if (!monitor->grafico) {
+        monitor_destruir(monitor);
+        return NULL;
+    }
+
+    // Todas las lineas tienen COLUMNAS_LINEA caracteres de una fuente monoespaciada,
+    // asi que comparten el ancho y se alinean a la izquierda con el mismo centro
+    char vacia[TAM_LINEA];
+    snprintf(vacia, sizeof(vacia), "%-*s", COLUMNAS_LINEA, "");
+    texto_medir(renderer, monitor->fuente, vacia, &monitor->anchoLinea, NULL);
+
+    int32_t centroX = MARGEN + ALTO_LINEA + monitor->anchoLinea / 2;
+    int32_t y = MARGEN + ALTO_GRAFICO + MARGEN;
+    for (int32_t i = 0; i < CANT_LINEAS; i++, y += ALTO_LINEA) {
+        monitor->lineas[i] = hud_inicializar(renderer, centroX, y + ALTO_LINEA / 2, vacia, TAM_LINEA,
+                                             monitor->fuente, _actualizar_linea, NULL);
+        if (!monitor->lineas[i]) {
+            monitor_destruir(monitor);
+            return NULL;
+        }
+    }
+
+    return monitor;
+}
+
+void monitor_alternar(tMonitor *monitor)
+{
+    monitor->visible = !monitor->visible;
+    monitor->graficoPendiente = 1;
+
+    // Lo acumulado mientras estuvo oculto no se muestra: arranca un intervalo nuevo
+    monitor->inicioIntervalo = SDL_GetTicks();
+    monitor->cuadrosIntervalo = 0;
+    monitor->presentadosIntervalo = 0;
+    monitor->sumaCuadro = 0;
+    memset(monitor->suma, 0, sizeof(monitor->suma));
+    memset(monitor->maximo, 0, sizeof(monitor->maximo));
+}
+
+int32_t monitor_visible(const tMonitor *monitor)
+{
+    return monitor && monitor->visible;
+}
+
+void monitor_registrar_cuadro(tMonitor *monitor, tRendimiento *rendimiento)
+{
+    if (!monitor || !rendimiento) {
+        return;
+    }
+
+    tGrafico *g = monitor->datosGrafico;
+    for (int32_t f = 0; f < CANT_FASES_GRAFICO; f++) {
+        double ms = rendimiento_total_ms(rendimiento, FASES_GRAFICO[f]);
+        g->ms[g->pos][f] = (float)ms;
+        monitor->suma[f] += ms;
+        if (ms > monitor->maximo[f]) {
+            monitor->maximo[f] = ms;
+        }
+    }
+    g->pos = (g->pos + 1) % HISTORIAL;
+
+    monitor->sumaCuadro += rendimiento_total_ms(rendimiento, FASE_CUADRO);
+    monitor->cuadrosIntervalo++;
+    if (rendimiento_total_ms(rendimiento, FASE_PRESENTAR) > 0) {
+        monitor->presentadosIntervalo++;
+    }
+    monitor->graficoPendiente = 1;
+}
+
+/* Regenera los textos con los promedios del intervalo y arranca uno nuevo. */
+static void _actualizar_textos(tMonitor *monitor, uint32_t ahora)
+{
+    uint32_t transcurrido = ahora - monitor->inicioIntervalo;
+    uint32_t cuadros = monitor->cuadrosIntervalo ? monitor->cuadrosIntervalo : 1;
+    char texto[TAM_LINEA];
+    char linea[TAM_LINEA] = {0}; // Sin basura tras el terminador: el HUD compara el dato completo
+
+    snprintf(texto, sizeof(texto), "FPS %5.1f   cuadro %6.2f ms",
+             transcurrido ? monitor->presentadosIntervalo * 1000.0 / transcurrido : 0.0,
+             monitor->sumaCuadro / cuadros);
+    snprintf(linea, sizeof(linea), "%-*.*s", COLUMNAS_LINEA, COLUMNAS_LINEA, texto);
+    hud_actualizar_dato(monitor->lineas[LINEA_FPS], linea);
+
+    for (int32_t f = 0; f < CANT_FASES_GRAFICO; f++) {
+        snprintf(texto, sizeof(texto), "%-11s %6.2f ms  max %6.2f",
+                 rendimiento_nombre_fase(FASES_GRAFICO[f]), monitor->suma[f] / cuadros, monitor->maximo[f]);
+        snprintf(linea, sizeof(linea), "%-*.*s", COLUMNAS_LINEA, COLUMNAS_LINEA, texto);
+        hud_actualizar_dato(monitor->lineas[LINEA_PRIMERA_FASE + f], linea);
+        monitor->suma[f] = 0;
+        monitor->maximo[f] = 0;
+    }
+
+    monitor->inicioIntervalo = ahora;
+    monitor->cuadrosIntervalo = 0;
+    monitor->presentadosIntervalo = 0;
+    monitor->sumaCuadro = 0;
+}
+
+void monitor_actualizar(tMonitor *monitor)
+{
+    if (!monitor_visible(monitor)) {
+        return;
+    }
+
+    uint32_t ahora = SDL_GetTicks();
+    if (ahora - monitor->inicioIntervalo >= INTERVALO_TEXTO_MS) {
+        _actualizar_textos(monitor, ahora);
+    }
+
+    if (monitor->graficoPendiente) {
+        hud_actualizar_dato(monitor->grafico, NULL);
+        monitor->graficoPendiente = 0;
+    }
+}
+
+void monitor_dibujar(const tMonitor *monitor)
+{
+    if (!monitor_visible(monitor)) {
+        return;
+    }
+
+    hud_dibujar(monitor->grafico);
+
+    int32_t y = MARGEN + ALTO_GRAFICO + MARGEN;
+    SDL_Rect panel = {0, y - MARGEN / 2, MARGEN * 2 + ALTO_LINEA + monitor->anchoLinea, CANT_LINEAS * ALTO_LINEA + MARGEN};
+    SDL_SetRenderDrawColor(monitor->renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(monitor->renderer, &panel);
+
+    // Cada fase lleva una muestra del color con el que aparece en el grafico
+    for (int32_t f = 0; f < CANT_FASES_GRAFICO; f++) {
+        SDL_Color c = COLORES_FASE[f];
+        SDL_Rect muestra = {MARGEN, y + (LINEA_PRIMERA_FASE + f) * ALTO_LINEA + 4, ALTO_LINEA - 8, ALTO_LINEA - 8};
+        SDL_SetRenderDrawColor(monitor->renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRect(monitor->renderer, &muestra);
+    }
+
+    for (int32_t i = 0; i < CANT_LINEAS; i++) {
+        hud_dibujar(monitor->lineas[i]);
+    }
+}
+
+void monitor_destruir(tMonitor *monitor)
+{
+    if (!monitor) {
+        return;
+    }
+
+    for (int32_t i = 0; i < CANT_LINEAS; i++) {
+        if (monitor->lineas[i]) {
+            hud_destruir(monitor->lineas[i]);
+        }
+    }
+    if (monitor->grafico) {
+        hud_destruir(monitor->grafico); // Libera tambien el lienzo y los datos del grafico
+    } else if (monitor->datosGrafico) {
+        _destruir_grafico(monitor->datosGrafico);
+    }
+    if (monitor->fuente) {
+        texto_destruir_fuente(monitor->fuente);
+    }
+    free(monitor);
+}
@@ -0,0 +1,74 @@
+#ifndef MONITOR_H_INCLUDED
+#define MONITOR_H_INCLUDED
+#include "rendimiento.h"
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+/**
+ * @brief Estructura opaca del monitor de rendimiento en pantalla.
+ * * * El monitor muestra los FPS, el tiempo promedio y maximo de cada fase del
+ * cuadro y un grafico con el historial de tiempos por cuadro, apilado por fase.
+ * Cada elemento es una instancia de 'tHUD': los textos se regeneran unas pocas
+ * veces por segundo y el grafico se redibuja sobre su propia textura.
+ */
+typedef struct sMonitor tMonitor;
+
+/**
+ * @brief Crea el monitor, inicialmente oculto.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ *
+ * @return tMonitor* Puntero al monitor creado, o NULL en caso de error.
+ */
+tMonitor* monitor_crear(SDL_Renderer *renderer);
+
+/**
+ * @brief Muestra u oculta el monitor.
+ *
+ * @param monitor Puntero al monitor.
+ */
+void monitor_alternar(tMonitor *monitor);
+
+/**
+ * @brief Indica si el monitor esta visible.
+ *
+ * @param monitor Puntero constante al monitor, o NULL.
+ *
+ * @return int32_t 1 si esta visible, 0 si no.
+ */
+int32_t monitor_visible(const tMonitor *monitor);
+
+/**
+ * @brief Incorpora al historial las fases medidas durante el ultimo cuadro.
+ * * * Lee el total de cada fase de 'rendimiento' desde su ultima limpieza, por lo
+ * que quien llama debe limpiarlo con 'rendimiento_limpiar' al cerrar cada cuadro.
+ *
+ * @param monitor Puntero al monitor.
+ * @param rendimiento Puntero a las mediciones del cuadro.
+ */
+void monitor_registrar_cuadro(tMonitor *monitor, tRendimiento *rendimiento);
+
+/**
+ * @brief Regenera las texturas del monitor que quedaron desactualizadas.
+ * * * Debe llamarse antes de componer el cuadro, ya que el grafico se dibuja
+ * cambiando el framebuffer objetivo.
+ *
+ * @param monitor Puntero al monitor.
+ */
+void monitor_actualizar(tMonitor *monitor);
+
+/**
+ * @brief Dibuja el monitor sobre el framebuffer actual, si esta visible.
+ *
+ * @param monitor Puntero constante al monitor.
+ */
+void monitor_dibujar(const tMonitor *monitor);
+
+/**
+ * @brief Libera los recursos del monitor.
+ *
+ * @param monitor Puntero al monitor a destruir.
+ */
+void monitor_destruir(tMonitor *monitor);
+
+#endif // MONITOR_H_INCLUDED
@@ -0,0 +1,101 @@
+#include "opciones.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LADO_TABLERO 10
+
+tOpciones opciones_por_defecto(void)
+{
+    tOpciones op;
+    op.autoplay = 0;
+    op.semilla  = 1;
+    op.filas    = 3;
+    op.columnas = 4;
+    op.cuadros  = CUADROS_BENCHMARK;
+    op.renderer = NULL;
+    op.rutaCsv  = RUTA_BENCHMARK;
+    op.rutaPaquete = NULL;
+    return op;
+}
+
+/* Convierte un entero sin signo; retorna -1 si el texto no es un número completo. */
+static int _leer_entero(const char *texto, unsigned long *valor)
+{
+    char *fin;
+    if (!texto || !*texto || *texto == '-') return -1;
+    *valor = strtoul(texto, &fin, 10);
+    return *fin == '\0' ? 0 : -1;
+}
+
+tError opciones_parsear(int argc, char *argv[], tOpciones *opciones)
+{
+    *opciones = opciones_por_defecto();
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        unsigned long n;
+
+        if (strcmp(arg, "--autoplay") == 0) {
+            opciones->autoplay = 1;
+            continue;
+        }
+
+        if (!valor) {
+            fprintf(stderr, "Error: falta el valor de %s\n", arg);
+            return ERR_ARGUMENTOS;
+        }
+
+        int valido = 1;
+        if (strcmp(arg, "--seed") == 0) {
+            valido = _leer_entero(valor, &n) == 0;
+            if (valido) opciones->semilla = (uint32_t)n;
+        }
+        else if (strcmp(arg, "--board") == 0) {
+            int filas, columnas;
+            char resto;
+            valido = sscanf(valor, "%dx%d%c", &filas, &columnas, &resto) == 2 &&
+                     filas >= 1 && columnas >= 1 &&
+                     filas <= MAX_LADO_TABLERO && columnas <= MAX_LADO_TABLERO &&
+                     (filas * columnas) % 2 == 0;
+            if (valido) {
+                opciones->filas = filas;
+                opciones->columnas = columnas;
+            }
+        }
+        else if (strcmp(arg, "--frames") == 0) {
+            valido = _leer_entero(valor, &n) == 0 && n > 0;
+            if (valido) opciones->cuadros = (uint32_t)n;
+        }
+        else if (strcmp(arg, "--renderer") == 0) {
+            opciones->renderer = valor;
+        }
+        else if (strcmp(arg, "--csv") == 0) {
+            opciones->rutaCsv = valor;
+        }
+        else if (strcmp(arg, "--pack") == 0) {
+            opciones->rutaPaquete = valor;
+        }
+        else {
+            fprintf(stderr, "Error: opcion desconocida %s\n", arg);
+            return ERR_ARGUMENTOS;
+        }
+
+        if (!valido) {
+            fprintf(stderr, "Error: valor invalido para %s: %s\n", arg, valor);
+            return ERR_ARGUMENTOS;
+        }
+        ++i; // Se consumió el valor
+    }
+
+    return TODO_OK;
+}
+
+void opciones_uso(const char *programa)
+{
+    fprintf(stderr,
+            "Uso: %s [--autoplay] [--seed S] [--board FxC] [--frames N]\n"
+            "          [--renderer NOMBRE] [--csv RUTA] [--pack RUTA]\n",
+            programa ? programa : "memotest");
+}
@@ -0,0 +1,39 @@
+#ifndef OPCIONES_H_INCLUDED
+#define OPCIONES_H_INCLUDED
+
+#include "errores.h"
+#include <stdint.h>
+
+#define CUADROS_BENCHMARK  600
+#define RUTA_BENCHMARK     "benchmark.csv"
+
+/* Opciones de línea de comandos. */
+typedef struct {
+    uint8_t     autoplay;      /* 1: partida automática sin ventana ni menú */
+    uint32_t    semilla;       /* semilla de rand() en modo autoplay */
+    int         filas;         /* tablero de la partida automática */
+    int         columnas;
+    uint32_t    cuadros;       /* cuadros a medir */
+    const char *renderer;      /* driver de SDL_Renderer, o NULL para el por defecto */
+    const char *rutaCsv;       /* reporte de tiempos por fase */
+    const char *rutaPaquete;   /* si no es NULL, arma el paquete de recursos y sale */
+} tOpciones;
+
+/* Devuelve las opciones de una ejecución normal (sin argumentos). */
+tOpciones opciones_por_defecto(void);
+
+/* Interpreta argv:
+     --autoplay            partida automática con clics sintéticos
+     --seed S              semilla (por defecto 1)
+     --board FxC           filas x columnas (por defecto 3x4)
+     --frames N            cuadros a medir
+     --renderer NOMBRE     driver de render (software, opengl, ...)
+     --csv RUTA            archivo del reporte
+     --pack RUTA           arma el paquete de recursos con img/, snd/ y fnt/
+   Retorna ERR_ARGUMENTOS si alguno es inválido. */
+tError opciones_parsear(int argc, char *argv[], tOpciones *opciones);
+
+/* Imprime la ayuda de uso en stderr. */
+void opciones_uso(const char *programa);
+
+#endif // OPCIONES_H_INCLUDED
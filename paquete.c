@@ -0,0 +1,387 @@
+#include "paquete.h"
+#include "vector.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define FIRMA_PAQUETE      "MEMOPAQ1"
+#define TAM_FIRMA          8
+#define TAM_RUTA_PAQUETE   56
+#define ALINEACION_PAQUETE 16
+
+typedef struct {
+    char firma[TAM_FIRMA];
+    uint32_t cantEntradas;
+    uint32_t reservado;
+} tCabeceraPaquete;
+
+typedef struct {
+    char ruta[TAM_RUTA_PAQUETE];
+    uint32_t desplazamiento;
+    uint32_t tamano;
+} tEntradaPaquete;
+
+static const uint8_t *datosPaquete = NULL;        // Archivo completo mapeado
+static size_t tamPaquete = 0;
+static const tEntradaPaquete *indicePaquete = NULL;
+static uint32_t cantEntradas = 0;
+static int64_t fechaPaquete = 0;                  // Modificacion del archivo al mapearlo
+#ifdef _WIN32
+static HANDLE archivoPaquete = INVALID_HANDLE_VALUE;
+static HANDLE mapeoPaquete = NULL;
+#endif
+
+
+/* ---- Mapeo del archivo ---- */
+
+static const uint8_t* _mapear(const char *ruta, size_t *tam)
+{
+#ifdef _WIN32
+    archivoPaquete = CreateFileA(ruta, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, NULL);
+    if (archivoPaquete == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    LARGE_INTEGER tamArchivo;
+    if (!GetFileSizeEx(archivoPaquete, &tamArchivo) || tamArchivo.QuadPart == 0) {
+        CloseHandle(archivoPaquete);
+        archivoPaquete = INVALID_HANDLE_VALUE;
+        return NULL;
+    }
+
+    mapeoPaquete = CreateFileMappingA(archivoPaquete, NULL, PAGE_READONLY, 0, 0, NULL);
+    const uint8_t *datos = mapeoPaquete ? MapViewOfFile(mapeoPaquete, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!datos) {
+        if (mapeoPaquete) CloseHandle(mapeoPaquete);
+        CloseHandle(archivoPaquete);
+        mapeoPaquete = NULL;
+        archivoPaquete = INVALID_HANDLE_VALUE;
+        return NULL;
+    }
+
+    *tam = (size_t)tamArchivo.QuadPart;
+    return datos;
+#else
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *datos = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // El mapeo sigue valido sin el descriptor
+    if (datos == MAP_FAILED) {
+        return NULL;
+    }
+
+    *tam = (size_t)info.st_size;
+    return (const uint8_t*)datos;
+#endif
+}
+
+static void _desmapear(void)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(datosPaquete);
+    CloseHandle(mapeoPaquete);
+    CloseHandle(archivoPaquete);
+    mapeoPaquete = NULL;
+    archivoPaquete = INVALID_HANDLE_VALUE;
+#else
+    munmap((void*)datosPaquete, tamPaquete);
+#endif
+    datosPaquete = NULL;
+    tamPaquete = 0;
+    indicePaquete = NULL;
+    cantEntradas = 0;
+    fechaPaquete = 0;
+}
+
+/* Verifica que cada entrada tenga la ruta terminada y los datos dentro del archivo. */
+static int _indice_valido(void)
+{
+    for (uint32_t i = 0; i < cantEntradas; i++) {
+        const tEntradaPaquete *e = &indicePaquete[i];
+        uint64_t fin = (uint64_t)SDL_SwapLE32(e->desplazamiento) + SDL_SwapLE32(e->tamano);
+        if (memchr(e->ruta, '\0', TAM_RUTA_PAQUETE) == NULL || fin > tamPaquete) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+tError paquete_abrir(const char *ruta)
+{
+    if (datosPaquete) {
+        paquete_cerrar();
+    }
+
+    datosPaquete = _mapear(ruta, &tamPaquete);
+    if (!datosPaquete) {
+        return ERR_ARCHIVO;
+    }
+
+    const tCabeceraPaquete *cabecera = (const tCabeceraPaquete*)datosPaquete;
+    if (tamPaquete < sizeof(tCabeceraPaquete) || memcmp(cabecera->firma, FIRMA_PAQUETE, TAM_FIRMA) != 0) {
+        fprintf(stderr, "Aviso: \"%s\" no es un paquete de recursos\n", ruta);
+        _desmapear();
+        return ERR_ARCHIVO;
+    }
+
+    cantEntradas = SDL_SwapLE32(cabecera->cantEntradas);
+    indicePaquete = (const tEntradaPaquete*)(datosPaquete + sizeof(tCabeceraPaquete));
+    if ((tamPaquete - sizeof(tCabeceraPaquete)) / sizeof(tEntradaPaquete) < cantEntradas || !_indice_valido()) {
+        fprintf(stderr, "Aviso: el paquete \"%s\" esta danado\n", ruta);
+        _desmapear();
+        return ERR_ARCHIVO;
+    }
+
+    struct stat info;
+    if (stat(ruta, &info) == 0) {
+        fechaPaquete = (int64_t)info.st_mtime;
+    }
+
+    return TODO_OK;
+}
+
+static int _comparar_ruta_entrada(const void *ruta, const void *entrada)
+{
+    return strcmp((const char*)ruta, ((const tEntradaPaquete*)entrada)->ruta);
+}
+
+static const tEntradaPaquete* _buscar_entrada(const char *ruta)
+{
+    if (!datosPaquete || !ruta) {
+        return NULL;
+    }
+
+    return bsearch(ruta, indicePaquete, cantEntradas, sizeof(tEntradaPaquete), _comparar_ruta_entrada);
+}
+
+SDL_RWops* paquete_leer(const char *ruta)
+{
+    const tEntradaPaquete *e = _buscar_entrada(ruta);
+    if (!e) {
+        return NULL;
+    }
+
+    return SDL_RWFromConstMem(datosPaquete + SDL_SwapLE32(e->desplazamiento), (int)SDL_SwapLE32(e->tamano));
+}
+
+int paquete_ubicar(const char *ruta, int64_t *fecha, uint32_t *desplazamiento, uint32_t *tamano)
+{
+    const tEntradaPaquete *e = _buscar_entrada(ruta);
+    if (!e) {
+        return 0;
+    }
+
+    *fecha = fechaPaquete;
+    *desplazamiento = SDL_SwapLE32(e->desplazamiento);
+    *tamano = SDL_SwapLE32(e->tamano);
+    return 1;
+}
+
+void paquete_cerrar(void)
+{
+    if (datosPaquete) {
+        _desmapear();
+    }
+}
+
+
+/* ---- Empaquetado ---- */
+
+/* Agrega a 'rutas' (vector de char[TAM_RUTA_PAQUETE]) los archivos de un directorio. */
+static tError _listar_directorio(const char *directorio, tVector *rutas)
+{
+    char ruta[TAM_RUTA_PAQUETE];
+
+#ifdef _WIN32
+    char patron[MAX_PATH];
+    snprintf(patron, sizeof(patron), "%s\\*", directorio);
+
+    WIN32_FIND_DATAA datos;
+    HANDLE busqueda = FindFirstFileA(patron, &datos);
+    if (busqueda == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "Error: No se pudo leer el directorio \"%s\"\n", directorio);
+        return ERR_ARCHIVO;
+    }
+
+    do {
+        if (datos.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            continue;
+        }
+        if (snprintf(ruta, sizeof(ruta), "%s/%s", directorio, datos.cFileName) >= (int)sizeof(ruta)) {
+            fprintf(stderr, "Aviso: ruta demasiado larga, se omite \"%s/%s\"\n", directorio, datos.cFileName);
+            continue;
+        }
+        if (vector_push_back(rutas, ruta) != 0) {
+            FindClose(busqueda);
+            return ERR_MEMORIA;
+        }
+    } while (FindNextFileA(busqueda, &datos));
+
+    FindClose(busqueda);
+#else
+    DIR *dir = opendir(directorio);
+    if (!dir) {
+        fprintf(stderr, "Error: No se pudo leer el directorio \"%s\"\n", directorio);
+        return ERR_ARCHIVO;
+    }
+
+    struct dirent *entrada;
+    while ((entrada = readdir(dir)) != NULL) {
+        if (snprintf(ruta, sizeof(ruta), "%s/%s", directorio, entrada->d_name) >= (int)sizeof(ruta)) {
+            fprintf(stderr, "Aviso: ruta demasiado larga, se omite \"%s/%s\"\n", directorio, entrada->d_name);
+            continue;
+        }
+
+        struct stat info;
+        if (stat(ruta, &info) != 0 || !S_ISREG(info.st_mode)) {
+            continue;
+        }
+        if (vector_push_back(rutas, ruta) != 0) {
+            closedir(dir);
+            return ERR_MEMORIA;
+        }
+    }
+
+    closedir(dir);
+#endif
+
+    return TODO_OK;
+}
+
+static int _comparar_rutas(const void *a, const void *b)
+{
+    return strcmp((const char*)a, (const char*)b);
+}
+
+/* Rellena con ceros hasta el próximo múltiplo de ALINEACION_PAQUETE. */
+static void _alinear(FILE *salida, long *posicion)
+{
+    static const uint8_t ceros[ALINEACION_PAQUETE] = {0};
+    long relleno = (ALINEACION_PAQUETE - *posicion % ALINEACION_PAQUETE) % ALINEACION_PAQUETE;
+    fwrite(ceros, 1, (size_t)relleno, salida);
+    *posicion += relleno;
+}
+
+/* Copia un archivo completo a la salida. Retorna los bytes copiados o -1. */
+static long _copiar_archivo(const char *ruta, FILE *salida)
+{
+    FILE *entrada = fopen(ruta, "rb");
+    if (!entrada) {
+        return -1;
+    }
+
+    uint8_t bloque[8192];
+    long total = 0;
+    size_t leidos;
+    while ((leidos = fread(bloque, 1, sizeof(bloque), entrada)) > 0) {
+        if (fwrite(bloque, 1, leidos, salida) != leidos) {
+            fclose(entrada);
+            return -1;
+        }
+        total += (long)leidos;
+    }
+
+    fclose(entrada);
+    return total;
+}
+
+tError paquete_crear(const char *rutaSalida, const char *const *directorios, size_t cantDirectorios)
+{
+    tVector *rutas = vector_create(TAM_RUTA_PAQUETE);
+    if (!rutas) {
+        return ERR_MEMORIA;
+    }
+
+    tError err = TODO_OK;
+    for (size_t i = 0; i < cantDirectorios && err == TODO_OK; i++) {
+        err = _listar_directorio(directorios[i], rutas);
+    }
+    if (err != TODO_OK) {
+        vector_destroy(rutas);
+        return err;
+    }
+
+    // El índice queda ordenado para buscar con bsearch
+    size_t cant = vector_size(rutas);
+    if (cant > 0) {
+        qsort(vector_get(rutas, 0), cant, TAM_RUTA_PAQUETE, _comparar_rutas);
+    }
+
+    tEntradaPaquete *indice = calloc(cant ? cant : 1, sizeof(tEntradaPaquete));
+    FILE *salida = fopen(rutaSalida, "wb");
+    if (!indice || !salida) {
+        if (salida) fclose(salida);
+        free(indice);
+        vector_destroy(rutas);
+        return indice ? ERR_ARCHIVO : ERR_MEMORIA;
+    }
+
+    // Primero se reserva el lugar de la cabecera y el índice; se escriben al final
+    long posicion = (long)(sizeof(tCabeceraPaquete) + cant * sizeof(tEntradaPaquete));
+    fseek(salida, posicion, SEEK_SET);
+
+    for (size_t i = 0; i < cant && err == TODO_OK; i++) {
+        const char *ruta = (const char*)vector_get(rutas, i);
+        _alinear(salida, &posicion);
+
+        long copiados = _copiar_archivo(ruta, salida);
+        if (copiados < 0) {
+            fprintf(stderr, "Error: No se pudo copiar \"%s\" al paquete\n", ruta);
+            err = ERR_ARCHIVO;
+            break;
+        }
+
+        memcpy(indice[i].ruta, ruta, TAM_RUTA_PAQUETE);
+        indice[i].desplazamiento = SDL_SwapLE32((uint32_t)posicion);
+        indice[i].tamano = SDL_SwapLE32((uint32_t)copiados);
+        posicion += copiados;
+    }
+
+    if (err == TODO_OK) {
+        tCabeceraPaquete cabecera;
+        memcpy(cabecera.firma, FIRMA_PAQUETE, TAM_FIRMA);
+        cabecera.cantEntradas = SDL_SwapLE32((uint32_t)cant);
+        cabecera.reservado = 0;
+
+        fseek(salida, 0, SEEK_SET);
+        if (fwrite(&cabecera, sizeof(cabecera), 1, salida) != 1 ||
+            (cant > 0 && fwrite(indice, sizeof(tEntradaPaquete), cant, salida) != cant)) {
+            err = ERR_ARCHIVO;
+        }
+    }
+
+    if (fclose(salida) != 0) {
+        err = ERR_ARCHIVO;
+    }
+    if (err == TODO_OK) {
+        printf("Paquete \"%s\": %u archivos, %ld bytes\n", rutaSalida, (unsigned)cant, posicion);
+    } else {
+        remove(rutaSalida);
+    }
+
+    free(indice);
+    vector_destroy(rutas);
+    return err;
+}
@@ -0,0 +1,43 @@
+#ifndef PAQUETE_H_INCLUDED
+#define PAQUETE_H_INCLUDED
+
+#include "errores.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+
+#define RUTA_PAQUETE "recursos.paq"
+
+/* Paquete de recursos: un único archivo con un índice ordenado por ruta y el
+   contenido de cada archivo alineado a 16 bytes. Se mapea en memoria una sola
+   vez y cada recurso se entrega a SDL sin volver a abrir archivos.
+
+   Formato (enteros de 32 bits little-endian):
+     cabecera  "MEMOPAQ1", cantidad de entradas, reservado
+     índice    por entrada: ruta (56 bytes, terminada en '\0'), desplazamiento, tamaño
+     datos     contenido de cada entrada, en el desplazamiento indicado */
+
+/* Mapea el paquete. Si no existe retorna ERR_ARCHIVO y los recursos se siguen
+   leyendo de img/, snd/ y fnt/. */
+tError paquete_abrir(const char *ruta);
+
+/* Devuelve un SDL_RWops de solo lectura sobre el contenido de 'ruta' dentro del
+   paquete (por ejemplo "img/background.jpg"), o NULL si no hay paquete abierto
+   o no contiene esa ruta. Los datos siguen mapeados hasta paquete_cerrar, así
+   que las fuentes abiertas con él deben cerrarse antes. Puede usarse desde
+   cualquier hilo. */
+SDL_RWops* paquete_leer(const char *ruta);
+
+/* Ubica 'ruta' dentro del paquete: fecha de modificación del paquete, y
+   desplazamiento y tamaño de la entrada. Identifica la versión exacta que
+   entrega paquete_leer. Retorna 0 si no hay paquete abierto o no la contiene. */
+int paquete_ubicar(const char *ruta, int64_t *fecha, uint32_t *desplazamiento, uint32_t *tamano);
+
+/* Libera el mapeo. */
+void paquete_cerrar(void);
+
+/* Herramienta de empaquetado: arma 'rutaSalida' con todos los archivos de los
+   directorios indicados (sin recorrer subdirectorios). */
+tError paquete_crear(const char *rutaSalida, const char *const *directorios, size_t cantDirectorios);
+
+#endif // PAQUETE_H_INCLUDED
@@ -1,7 +1,7 @@
 #include "presentacion.h"
-#include "imagenes.h"
 #include "texto.h"
 #include "sonidos.h"
+#include "recursos.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <string.h>
@@ -10,23 +10,44 @@
 // Tiempo de parpadeo del cursor en ms
 #define CARET_BLINK_MS 500
 
+// Espera del audio pendiente para el primer sonido (ver presentacion_esperar_audio)
+static tEsperarAudio esperarAudio = NULL;
+static void *contextoAudio = NULL;
+
+void presentacion_esperar_audio(tEsperarAudio esperar, void *contexto)
+{
+    esperarAudio = esperar;
+    contextoAudio = contexto;
+}
+
+static tSonido* _iniciar_sonido(const char *sonidoPath)
+{
+    if (esperarAudio) {
+        tEsperarAudio esperar = esperarAudio;
+        esperarAudio = NULL;
+        esperar(contextoAudio);
+    }
+
+    tSonido *sonido = recursos_sonido(sonidoPath);
+    if (sonido) {
+        sonidos_configurar_voces(sonido, 1, PRIORIDAD_ALTA); // La musica en bucle no cede su canal a los efectos
+        sonidos_reproducir(sonido, -1);
+    }
+    return sonido;
+}
+
 tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *fondoPath, const char *sonidoPath, const char *mensaje,
                              char *outName, size_t maxLen)
 {
     if (!renderer || !fuente || !outName || maxLen == 0) return ERR_MEMORIA;
 
     /* Cargar fuente personalizada para la presentación */
-    TTF_Font *fuentePresentacion = texto_cargar_fuente("fnt/font4.TTF", 36);
+    TTF_Font *fuentePresentacion = recursos_fuente("fnt/font4.TTF", 36);
     TTF_Font *fuenteUsada = fuentePresentacion ? fuentePresentacion : fuente;
 
-    SDL_Texture *fondo = imagenes_cargar_gpu(renderer, fondoPath);
+    SDL_Texture *fondo = recursos_textura(renderer, fondoPath);
     tSonido *sonido = NULL;
-    if (sonidoPath) {
-        sonido = sonidos_cargar(sonidoPath);
-        if (sonido) {
-            sonidos_reproducir(sonido, -1);
-        }
-    }
+    int sonidoPendiente = sonidoPath != NULL;   // Arranca después del primer cuadro
 
     /* Obtener dimensiones de la ventana */
     int anchoVentana, altoVentana;
@@ -46,15 +67,27 @@ tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char
     int done = 0;
     uint32_t lastBlink = SDL_GetTicks();
     int caretVisible = 1;
+    int redibujar = 1;
 
     while (!done) {
         SDL_Event ev;
+
+        /* Sin cambios pendientes se bloquea hasta la próxima tecla o hasta
+           que toque el próximo parpadeo del cursor */
+        if (!redibujar) {
+            uint32_t transcurrido = SDL_GetTicks() - lastBlink;
+            if (transcurrido < CARET_BLINK_MS)
+                SDL_WaitEventTimeout(NULL, (int)(CARET_BLINK_MS - transcurrido));
+        }
+
         while (SDL_PollEvent(&ev)) {
+            redibujar = 1;
             if (ev.type == SDL_QUIT) {
                 SDL_StopTextInput();
-                if (fuentePresentacion) texto_destruir_fuente(fuentePresentacion);
-                if (sonido) sonidos_destruir(sonido);
-                if (fondo) SDL_DestroyTexture(fondo);
+                recursos_soltar(fuentePresentacion);
+                sonidos_detener(sonido);
+                recursos_soltar(sonido);
+                recursos_soltar(fondo);
                 return ERR_SDL;
             } else if (ev.type == SDL_TEXTINPUT) {
                 const char *txt = ev.text.text;
@@ -81,8 +114,12 @@ tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char
         if (now - lastBlink >= CARET_BLINK_MS) {
             caretVisible = !caretVisible;
             lastBlink = now;
+            redibujar = 1;
         }
 
+        if (!redibujar) continue;
+        redibujar = 0;
+
         /* ---- Render ---- */
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
@@ -105,17 +142,11 @@ tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char
 
         /* Texto de instrucción centrado dentro del recuadro */
         SDL_Color blanco = {255, 255, 255, 255};
-       SDL_Texture *tInstruccion = texto_crear_textura(renderer, fuenteUsada,
-    mensaje ? mensaje : "Ingrese su nombre:", blanco);
-;
-        if (tInstruccion) {
-            int w, h;
-            SDL_QueryTexture(tInstruccion, NULL, NULL, &w, &h);
-            SDL_Rect dst = { recuadroX + (recuadroAncho - w) / 2,
-                             recuadroY + 20, w, h };
-            SDL_RenderCopy(renderer, tInstruccion, NULL, &dst);
-            SDL_DestroyTexture(tInstruccion);
-        }
+        const char *instruccion = mensaje ? mensaje : "Ingrese su nombre:";
+        int w, h;
+        texto_medir(renderer, fuenteUsada, instruccion, &w, NULL);
+        texto_dibujar(renderer, fuenteUsada, instruccion,
+                      recuadroX + (recuadroAncho - w) / 2, recuadroY + 20, blanco);
 
         /* Campo de texto con fondo oscuro */
         int campoAncho = recuadroAncho - 60;
@@ -135,31 +166,22 @@ tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char
         else
             snprintf(display, sizeof(display), "%s ", buffer);
 
-        SDL_Texture *tNombre = texto_crear_textura(renderer, fuenteUsada, display, blanco);
-        if (tNombre) {
-            int w, h;
-            SDL_QueryTexture(tNombre, NULL, NULL, &w, &h);
-            /* Centrado vertical dentro del campo, alineado a la izquierda con padding */
-            SDL_Rect dst = { campoX + 10, campoY + (campoAlto - h) / 2, w, h };
-            SDL_RenderCopy(renderer, tNombre, NULL, &dst);
-            SDL_DestroyTexture(tNombre);
-        }
+        texto_medir(renderer, fuenteUsada, display, NULL, &h);
+        /* Centrado vertical dentro del campo, alineado a la izquierda con padding */
+        texto_dibujar(renderer, fuenteUsada, display, campoX + 10, campoY + (campoAlto - h) / 2, blanco);
 
         /* Indicación de ENTER */
         SDL_Color gris = {180, 180, 180, 255};
-        SDL_Texture *tEnter = texto_crear_textura(renderer, fuenteUsada,
-            "(ENTER para continuar)", gris);
-        if (tEnter) {
-            int w, h;
-            SDL_QueryTexture(tEnter, NULL, NULL, &w, &h);
-            SDL_Rect dst = { recuadroX + (recuadroAncho - w) / 2,
-                             recuadroY + recuadroAlto - h - 15, w, h };
-            SDL_RenderCopy(renderer, tEnter, NULL, &dst);
-            SDL_DestroyTexture(tEnter);
-        }
+        texto_medir(renderer, fuenteUsada, "(ENTER para continuar)", &w, &h);
+        texto_dibujar(renderer, fuenteUsada, "(ENTER para continuar)",
+                      recuadroX + (recuadroAncho - w) / 2, recuadroY + recuadroAlto - h - 15, gris);
 
         SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+
+        if (sonidoPendiente && !done) {
+            sonidoPendiente = 0;
+            sonido = _iniciar_sonido(sonidoPath);
+        }
     }
 
     SDL_StopTextInput();
@@ -167,14 +189,12 @@ tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char
     strncpy(outName, buffer, maxLen - 1);
     outName[maxLen - 1] = '\0';
 
-    if (fuentePresentacion) texto_destruir_fuente(fuentePresentacion);
+    recursos_soltar(fuentePresentacion);
 
-    if (sonido) {
-        sonidos_destruir(sonido);
-    }
-    if (fondo) {
-        SDL_DestroyTexture(fondo);
-    }
+    /* La musica quedaba en bucle: al no destruirse el sonido compartido, se la detiene */
+    sonidos_detener(sonido);
+    recursos_soltar(sonido);
+    recursos_soltar(fondo);
 
     return TODO_OK;
 }
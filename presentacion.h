@@ -5,10 +5,19 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+/* Se llama antes de usar el audio por primera vez, p. ej. para esperar al hilo
+   que abre el dispositivo. */
+typedef void (*tEsperarAudio)(void *contexto);
+
 /*
   Muestra la pantalla de presentación usando la textura de fondo y reproduce un sonido.
+  El sonido arranca después del primer cuadro, así la ventana no espera al audio.
 
  */
 tError presentacion_mostrar(SDL_Renderer *renderer, TTF_Font *fuente, const char *fondoPath, const char *sonidoPath, const char *mensaje, char *outName, size_t maxLen);
 
+/* Registra la espera del audio para la próxima presentación; se llama una sola vez.
+   Con NULL se quita. */
+void presentacion_esperar_audio(tEsperarAudio esperar, void *contexto);
+
 #endif // PRESENTACION_H_INCLUDED
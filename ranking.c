@@ -133,8 +133,7 @@ void ranking_agregar(tVector *ranking, const char *nombre, int puntaje)
     ranking_ordenar_seleccion(ranking, cmpPuntajeDesc);
 
     /* Recortar al top MAX_RANKING */
-    while (vector_size(ranking) > MAX_RANKING)
-        vector_remove_at(ranking, vector_size(ranking) - 1);
+    vector_truncate(ranking, MAX_RANKING);
 }
 
 
@@ -175,16 +174,10 @@ void ranking_renderizar(SDL_Renderer *renderer, TTF_Font *fuenteGrande,
     if (fuenteGrande)
     {
         SDL_Color dorado = {255, 200, 50, 255};
-        SDL_Texture *tTitulo = texto_crear_textura(renderer, fuenteGrande,
-                                                   "RANKING TOP 10", dorado);
-        if (tTitulo)
-        {
-            int w, h;
-            SDL_QueryTexture(tTitulo, NULL, NULL, &w, &h);
-            SDL_Rect dst = { panelX + (anchoPanel - w) / 2, panelY + 5, w, h };
-            SDL_RenderCopy(renderer, tTitulo, NULL, &dst);
-            SDL_DestroyTexture(tTitulo);
-        }
+        int w;
+        texto_medir(renderer, fuenteGrande, "RANKING TOP 10", &w, NULL);
+        texto_dibujar(renderer, fuenteGrande, "RANKING TOP 10",
+                      panelX + (anchoPanel - w) / 2, panelY + 5, dorado);
     }
 
     /* Entradas del ranking */
@@ -211,30 +204,15 @@ void ranking_renderizar(SDL_Renderer *renderer, TTF_Font *fuenteGrande,
             else if (i == 2) color = bronce;
             else             color = blanco;
 
-            SDL_Texture *tLinea = texto_crear_textura(renderer, fuenteChica,
-                                                      linea, color);
-            if (tLinea)
-            {
-                int w, h;
-                SDL_QueryTexture(tLinea, NULL, NULL, &w, &h);
-                SDL_Rect dst = { panelX + padding, yBase + (int)i * altoLinea, w, h };
-                SDL_RenderCopy(renderer, tLinea, NULL, &dst);
-                SDL_DestroyTexture(tLinea);
-            }
+            texto_dibujar(renderer, fuenteChica, linea,
+                          panelX + padding, yBase + (int)i * altoLinea, color);
         }
 
         /* Mensaje para salir */
-        SDL_Texture *tMsg = texto_crear_textura(renderer, fuenteChica,
-                                                "Presione ESC para salir",
-                                                (SDL_Color){180,180,180,255});
-        if (tMsg)
-        {
-            int w, h;
-            SDL_QueryTexture(tMsg, NULL, NULL, &w, &h);
-            SDL_Rect dst = { panelX + (anchoPanel - w) / 2,
-                             panelY + altoPanel + 10, w, h };
-            SDL_RenderCopy(renderer, tMsg, NULL, &dst);
-            SDL_DestroyTexture(tMsg);
-        }
+        int w;
+        texto_medir(renderer, fuenteChica, "Presione ESC para salir", &w, NULL);
+        texto_dibujar(renderer, fuenteChica, "Presione ESC para salir",
+                      panelX + (anchoPanel - w) / 2, panelY + altoPanel + 10,
+                      (SDL_Color){180,180,180,255});
     }
 }
@@ -0,0 +1,290 @@
+#include "recursos.h"
+#include "imagenes.h"
+#include "texto.h"
+#include "vector.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAM_CLAVE 512
+
+typedef struct {
+    char *clave;
+    void *recurso;            // NULL si la carga fallo
+    tLiberarRecurso liberar;
+    uint32_t referencias;
+} tRecurso;
+
+typedef struct {
+    SDL_Renderer *renderer;
+    const char *path;
+    uint32_t tam;
+} tParametrosCarga;
+
+static tVector *recursos = NULL; // Vector de tRecurso*
+
+
+static void _liberar_entrada(tRecurso *entrada)
+{
+    if (entrada->recurso && entrada->liberar) {
+        entrada->liberar(entrada->recurso);
+    }
+    free(entrada->clave);
+    free(entrada);
+}
+
+static tRecurso* _buscar_clave(const char *clave)
+{
+    for (size_t i = 0; i < vector_size(recursos); i++) {
+        tRecurso *entrada = *(tRecurso**)vector_get(recursos, i);
+        if (strcmp(entrada->clave, clave) == 0) {
+            return entrada;
+        }
+    }
+
+    return NULL;
+}
+
+// Libera un recurso que no llego a quedar en la cache
+static void _descartar(void *recurso, tLiberarRecurso liberar)
+{
+    if (recurso && liberar) {
+        liberar(recurso);
+    }
+}
+
+/* Agrega una entrada nueva con una referencia (o ninguna si el recurso es NULL). */
+static tRecurso* _agregar_entrada(const char *clave, void *recurso, tLiberarRecurso liberar)
+{
+    if (!recursos) {
+        recursos = vector_create(sizeof(tRecurso*));
+        if (!recursos) {
+            return NULL;
+        }
+    }
+
+    tRecurso *entrada = malloc(sizeof(tRecurso));
+    if (!entrada) {
+        return NULL;
+    }
+
+    entrada->clave = malloc(strlen(clave) + 1);
+    if (!entrada->clave) {
+        free(entrada);
+        return NULL;
+    }
+    strcpy(entrada->clave, clave);
+
+    entrada->recurso = recurso;
+    entrada->liberar = liberar;
+    entrada->referencias = recurso ? 1 : 0;
+
+    if (vector_push_back(recursos, &entrada) != 0) {
+        free(entrada->clave);
+        free(entrada);
+        return NULL;
+    }
+
+    return entrada;
+}
+
+void* recursos_obtener(const char *clave, tCargarRecurso cargar, tLiberarRecurso liberar, void *contexto)
+{
+    if (!clave || !cargar) {
+        return NULL;
+    }
+
+    tRecurso *entrada = _buscar_clave(clave);
+    if (entrada) {
+        if (entrada->recurso) {
+            entrada->referencias++;
+        }
+        return entrada->recurso;
+    }
+
+    void *recurso = cargar(contexto);
+    if (!_agregar_entrada(clave, recurso, liberar)) {
+        _descartar(recurso, liberar); // Fuera de la cache nadie lo liberaria
+        return NULL;
+    }
+    return recurso;
+}
+
+void* recursos_buscar(const char *clave)
+{
+    tRecurso *entrada = clave ? _buscar_clave(clave) : NULL;
+    if (!entrada || !entrada->recurso) {
+        return NULL;
+    }
+
+    entrada->referencias++;
+    return entrada->recurso;
+}
+
+void* recursos_adoptar(const char *clave, void *recurso, tLiberarRecurso liberar)
+{
+    if (!clave || !recurso) {
+        return NULL;
+    }
+
+    tRecurso *entrada = _buscar_clave(clave);
+    if (entrada && entrada->recurso) {
+        // Otro pedido lo cargo antes: se conserva el de la cache
+        if (liberar) {
+            liberar(recurso);
+        }
+        entrada->referencias++;
+        return entrada->recurso;
+    }
+
+    if (entrada) {
+        // Reemplaza una carga fallida recordada
+        entrada->recurso = recurso;
+        entrada->liberar = liberar;
+        entrada->referencias = 1;
+        return recurso;
+    }
+
+    if (!_agregar_entrada(clave, recurso, liberar)) {
+        _descartar(recurso, liberar);
+        return NULL;
+    }
+    return recurso;
+}
+
+static void* _cargar_textura(void *contexto)
+{
+    const tParametrosCarga *p = (const tParametrosCarga*)contexto;
+    return imagenes_cargar_gpu(p->renderer, p->path);
+}
+
+static void _liberar_textura(void *recurso)
+{
+    SDL_DestroyTexture((SDL_Texture*)recurso);
+}
+
+static void* _cargar_fuente(void *contexto)
+{
+    const tParametrosCarga *p = (const tParametrosCarga*)contexto;
+    return texto_cargar_fuente(p->path, p->tam);
+}
+
+static void _liberar_fuente(void *recurso)
+{
+    texto_destruir_fuente((TTF_Font*)recurso);
+}
+
+static void* _cargar_sonido(void *contexto)
+{
+    const tParametrosCarga *p = (const tParametrosCarga*)contexto;
+    return sonidos_cargar(p->path);
+}
+
+static void _liberar_sonido(void *recurso)
+{
+    sonidos_destruir((tSonido*)recurso);
+}
+
+/* Arma la clave "prefijo:path" (y "@tam" si corresponde). */
+static void _armar_clave(char *clave, size_t tamClave, const char *prefijo, const char *path, uint32_t tam)
+{
+    if (tam) {
+        snprintf(clave, tamClave, "%s:%s@%u", prefijo, path, tam);
+    } else {
+        snprintf(clave, tamClave, "%s:%s", prefijo, path);
+    }
+}
+
+static void* _obtener_archivo(const char *prefijo, tParametrosCarga *p, tCargarRecurso cargar, tLiberarRecurso liberar)
+{
+    if (!p->path) {
+        return NULL;
+    }
+
+    char clave[TAM_CLAVE];
+    _armar_clave(clave, sizeof(clave), prefijo, p->path, p->tam);
+    return recursos_obtener(clave, cargar, liberar, p);
+}
+
+SDL_Texture* recursos_textura(SDL_Renderer *renderer, const char *path)
+{
+    tParametrosCarga p = {renderer, path, 0};
+    return (SDL_Texture*)_obtener_archivo("tex", &p, _cargar_textura, _liberar_textura);
+}
+
+TTF_Font* recursos_fuente(const char *path, uint32_t tam)
+{
+    tParametrosCarga p = {NULL, path, tam};
+    return (TTF_Font*)_obtener_archivo("ttf", &p, _cargar_fuente, _liberar_fuente);
+}
+
+tSonido* recursos_sonido(const char *path)
+{
+    tParametrosCarga p = {NULL, path, 0};
+    return (tSonido*)_obtener_archivo("snd", &p, _cargar_sonido, _liberar_sonido);
+}
+
+tSonido* recursos_buscar_sonido(const char *path)
+{
+    if (!path) {
+        return NULL;
+    }
+
+    char clave[TAM_CLAVE];
+    _armar_clave(clave, sizeof(clave), "snd", path, 0);
+    return (tSonido*)recursos_buscar(clave);
+}
+
+tSonido* recursos_adoptar_sonido(const char *path, tSonido *sonido)
+{
+    if (!path) {
+        return NULL;
+    }
+
+    char clave[TAM_CLAVE];
+    _armar_clave(clave, sizeof(clave), "snd", path, 0);
+    return (tSonido*)recursos_adoptar(clave, sonido, _liberar_sonido);
+}
+
+void recursos_soltar(const void *recurso)
+{
+    if (!recurso) {
+        return;
+    }
+
+    for (size_t i = 0; i < vector_size(recursos); i++) {
+        tRecurso *entrada = *(tRecurso**)vector_get(recursos, i);
+        if (entrada->recurso == recurso) {
+            if (entrada->referencias > 0) {
+                entrada->referencias--;
+            }
+            return;
+        }
+    }
+}
+
+int recursos_desalojar_clave(const char *clave)
+{
+    for (size_t i = 0; clave && i < vector_size(recursos); i++) {
+        tRecurso *entrada = *(tRecurso**)vector_get(recursos, i);
+        if (strcmp(entrada->clave, clave) == 0) {
+            if (entrada->referencias > 0) {
+                return 0;
+            }
+            _liberar_entrada(entrada);
+            vector_swap_remove(recursos, i); // La busqueda es lineal: el orden no importa
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void recursos_finalizar(void)
+{
+    for (size_t i = 0; i < vector_size(recursos); i++) {
+        _liberar_entrada(*(tRecurso**)vector_get(recursos, i));
+    }
+    vector_destroy(recursos);
+    recursos = NULL;
+}
@@ -0,0 +1,146 @@
+#ifndef RECURSOS_H_INCLUDED
+#define RECURSOS_H_INCLUDED
+#include "sonidos.h"
+#include <stdint.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+/**
+ * @brief Firma de la funcion que carga un recurso que no esta en la cache.
+ *
+ * @param contexto Puntero a los parametros necesarios para la carga.
+ *
+ * @return void* Puntero al recurso cargado, o NULL si no se pudo cargar.
+ */
+typedef void* (*tCargarRecurso) (void *contexto);
+
+/**
+ * @brief Firma de la funcion que libera un recurso al desalojarlo de la cache.
+ *
+ * @param recurso Puntero al recurso a liberar.
+ */
+typedef void (*tLiberarRecurso) (void *recurso);
+
+/**
+ * @brief Obtiene un recurso compartido identificado por una clave.
+ * * * Si la clave ya esta en la cache devuelve el mismo recurso sin volver a cargarlo;
+ * si no, lo carga con 'cargar' y lo guarda. Cada llamada suma una referencia que
+ * debe devolverse con 'recursos_soltar'. Las cargas fallidas tambien se recuerdan,
+ * para no reintentar la lectura del disco en cada pedido.
+ *
+ * @param clave Cadena que identifica al recurso junto con sus parametros.
+ * @param cargar Callback que carga el recurso la primera vez.
+ * @param liberar Callback que lo libera al desalojarlo.
+ * @param contexto Puntero que se pasa a 'cargar'.
+ *
+ * @return void* Puntero al recurso, o NULL si no se pudo cargar o guardar en la cache
+ * (en ese caso ya se libero con 'liberar').
+ */
+void* recursos_obtener(const char *clave, tCargarRecurso cargar, tLiberarRecurso liberar, void *contexto);
+
+/**
+ * @brief Busca un recurso en la cache sin cargarlo.
+ *
+ * @param clave Cadena que identifica al recurso.
+ *
+ * @return void* Puntero al recurso con una referencia mas, o NULL si no esta cargado.
+ */
+void* recursos_buscar(const char *clave);
+
+/**
+ * @brief Guarda en la cache un recurso que ya se cargo por otro medio.
+ * * * Se usa para los recursos decodificados fuera del hilo principal. Si la clave
+ * ya tenia un recurso cargado, se libera el recibido y se devuelve el existente.
+ *
+ * @param clave Cadena que identifica al recurso.
+ * @param recurso Puntero al recurso; la cache pasa a ser su duenia.
+ * @param liberar Callback que lo libera al desalojarlo.
+ *
+ * @return void* Puntero al recurso de la cache con una referencia, o NULL si 'recurso' era NULL
+ * o no se pudo guardar (en ese caso ya se libero con 'liberar').
+ */
+void* recursos_adoptar(const char *clave, void *recurso, tLiberarRecurso liberar);
+
+/**
+ * @brief Obtiene una textura compartida cargada desde un archivo de imagen.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param path Ruta al archivo.
+ *
+ * @return SDL_Texture* Puntero a la textura, o NULL si no se pudo cargar.
+ *
+ * @note No debe destruirse con 'SDL_DestroyTexture': se devuelve con 'recursos_soltar'.
+ */
+SDL_Texture* recursos_textura(SDL_Renderer *renderer, const char *path);
+
+/**
+ * @brief Obtiene una fuente compartida para una ruta y un tamano.
+ *
+ * @param path Ruta al archivo .ttf.
+ * @param tam Tamano de la fuente en puntos.
+ *
+ * @return TTF_Font* Puntero a la fuente, o NULL si no se pudo cargar.
+ *
+ * @note No debe destruirse con 'texto_destruir_fuente': se devuelve con 'recursos_soltar'.
+ */
+TTF_Font* recursos_fuente(const char *path, uint32_t tam);
+
+/**
+ * @brief Obtiene un sonido compartido cargado desde un archivo de audio.
+ *
+ * @param path Ruta al archivo.
+ *
+ * @return tSonido* Puntero al sonido, o NULL si no se pudo cargar.
+ *
+ * @note No debe destruirse con 'sonidos_destruir': se devuelve con 'recursos_soltar'.
+ * Soltarlo no detiene su reproduccion (ver 'sonidos_detener').
+ */
+tSonido* recursos_sonido(const char *path);
+
+/**
+ * @brief Busca un sonido en la cache sin cargarlo (misma clave que 'recursos_sonido').
+ *
+ * @param path Ruta al archivo.
+ *
+ * @return tSonido* Puntero al sonido con una referencia mas, o NULL si no esta cargado.
+ */
+tSonido* recursos_buscar_sonido(const char *path);
+
+/**
+ * @brief Guarda en la cache un sonido ya decodificado (ver 'recursos_adoptar').
+ *
+ * @param path Ruta al archivo, con la que se lo encontrara despues.
+ * @param sonido Puntero al sonido; la cache pasa a ser su duenia.
+ *
+ * @return tSonido* Puntero al sonido de la cache con una referencia, o NULL si 'sonido' era NULL.
+ */
+tSonido* recursos_adoptar_sonido(const char *path, tSonido *sonido);
+
+/**
+ * @brief Devuelve una referencia a un recurso obtenido de la cache.
+ * * * El recurso sigue cargado aunque su cuenta llegue a cero, listo para el proximo
+ * pedido, hasta que se lo desaloje de forma explicita.
+ *
+ * @param recurso Puntero al recurso, o NULL (no hace nada).
+ */
+void recursos_soltar(const void *recurso);
+
+/**
+ * @brief Libera el recurso de una clave si ya no tiene referencias.
+ * * * Sirve para descartar un recurso que no se va a volver a pedir (p. ej. el
+ * atlas de un tablero que cambio) sin vaciar el resto de la cache.
+ *
+ * @param clave Cadena con la que se lo obtuvo.
+ *
+ * @return int 1 si se desalojo, 0 si no estaba en la cache o sigue en uso.
+ */
+int recursos_desalojar_clave(const char *clave);
+
+/**
+ * @brief Libera todos los recursos de la cache, tengan o no referencias.
+ * * * Debe llamarse antes de finalizar los subsistemas de texto y sonido y de
+ * destruir el renderizador.
+ */
+void recursos_finalizar(void);
+
+#endif // RECURSOS_H_INCLUDED
@@ -0,0 +1,135 @@
+#include "rendimiento.h"
+#include "vector.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct sRendimiento {
+    tVector *muestras[FASE_CANT];  /* Vector de double: duración en ms */
+    uint64_t inicio[FASE_CANT];    /* Contador de alta resolución al iniciar */
+    double   msPorTick;
+};
+
+static const char *NOMBRES_FASE[FASE_CANT] = {
+    "eventos", "actualizar", "renderizar", "capa_fondo",
+    "capa_escena", "capa_hud", "presentar", "cuadro"
+};
+
+static int _comparar_double(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Percentil por rango más cercano sobre muestras ya ordenadas. */
+static double _percentil(const double *ordenadas, size_t cant, int percentil)
+{
+    size_t rango = (cant * (size_t)percentil + 99) / 100;
+    return ordenadas[rango > 0 ? rango - 1 : 0];
+}
+
+tRendimiento* rendimiento_crear(void)
+{
+    tRendimiento *r = malloc(sizeof(tRendimiento));
+    if (!r) return NULL;
+    memset(r, 0, sizeof(tRendimiento));
+
+    for (int f = 0; f < FASE_CANT; ++f) {
+        r->muestras[f] = vector_create(sizeof(double));
+        if (!r->muestras[f]) {
+            rendimiento_destruir(r);
+            return NULL;
+        }
+    }
+
+    r->msPorTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return r;
+}
+
+void rendimiento_iniciar(tRendimiento *r, tFase fase)
+{
+    if (!r || fase >= FASE_CANT) return;
+    r->inicio[fase] = SDL_GetPerformanceCounter();
+}
+
+void rendimiento_terminar(tRendimiento *r, tFase fase)
+{
+    if (!r || fase >= FASE_CANT) return;
+    double ms = (double)(SDL_GetPerformanceCounter() - r->inicio[fase]) * r->msPorTick;
+    vector_push_back(r->muestras[fase], &ms);
+}
+
+void rendimiento_resumir(tRendimiento *r, tFase fase, tResumenFase *resumen)
+{
+    memset(resumen, 0, sizeof(tResumenFase));
+    if (!r || fase >= FASE_CANT) return;
+
+    size_t cant = vector_size(r->muestras[fase]);
+    if (cant == 0) return;
+
+    double *ordenadas = malloc(cant * sizeof(double));
+    if (!ordenadas) return;
+    memcpy(ordenadas, r->muestras[fase]->data, cant * sizeof(double));
+    qsort(ordenadas, cant, sizeof(double), _comparar_double);
+
+    double suma = 0;
+    for (size_t i = 0; i < cant; ++i) suma += ordenadas[i];
+
+    resumen->muestras = (uint32_t)cant;
+    resumen->minimo   = ordenadas[0];
+    resumen->promedio = suma / (double)cant;
+    resumen->p95      = _percentil(ordenadas, cant, 95);
+    resumen->p99      = _percentil(ordenadas, cant, 99);
+    free(ordenadas);
+}
+
+double rendimiento_total_ms(tRendimiento *r, tFase fase)
+{
+    if (!r || fase >= FASE_CANT) return 0;
+
+    double suma = 0;
+    for (size_t i = 0; i < vector_size(r->muestras[fase]); ++i)
+        suma += *(double*)vector_get(r->muestras[fase], i);
+    return suma;
+}
+
+void rendimiento_limpiar(tRendimiento *r)
+{
+    if (!r) return;
+    for (int f = 0; f < FASE_CANT; ++f)
+        vector_clear(r->muestras[f]);
+}
+
+const char* rendimiento_nombre_fase(tFase fase)
+{
+    return fase < FASE_CANT ? NOMBRES_FASE[fase] : "?";
+}
+
+int rendimiento_exportar_csv(tRendimiento *r, const char *ruta)
+{
+    if (!r || !ruta) return -1;
+    FILE *archivo = fopen(ruta, "w");
+    if (!archivo) return -1;
+
+    fprintf(archivo, "fase,muestras,min_ms,avg_ms,p95_ms,p99_ms\n");
+    for (int f = 0; f < FASE_CANT; ++f) {
+        tResumenFase res;
+        rendimiento_resumir(r, (tFase)f, &res);
+        fprintf(archivo, "%s,%u,%.4f,%.4f,%.4f,%.4f\n", rendimiento_nombre_fase((tFase)f),
+                res.muestras, res.minimo, res.promedio, res.p95, res.p99);
+    }
+
+    fclose(archivo);
+    return 0;
+}
+
+void rendimiento_destruir(tRendimiento *r)
+{
+    if (!r) return;
+    for (int f = 0; f < FASE_CANT; ++f) {
+        if (r->muestras[f]) vector_destroy(r->muestras[f]);
+    }
+    free(r);
+}
@@ -0,0 +1,58 @@
+#ifndef RENDIMIENTO_H_INCLUDED
+#define RENDIMIENTO_H_INCLUDED
+
+#include <stdint.h>
+
+/* Fases de un cuadro que se miden por separado. */
+typedef enum {
+    FASE_EVENTOS,
+    FASE_ACTUALIZAR,
+    FASE_RENDERIZAR,   /* juego_renderizar completo, incluye capas y presentación */
+    FASE_CAPA_FONDO,
+    FASE_CAPA_ESCENA,
+    FASE_CAPA_HUD,
+    FASE_PRESENTAR,    /* SDL_RenderPresent */
+    FASE_CUADRO,       /* cuadro completo, de punta a punta */
+    FASE_CANT
+} tFase;
+
+/* Estadísticas de una fase, en milisegundos. */
+typedef struct {
+    uint32_t muestras;
+    double   minimo;
+    double   promedio;
+    double   p95;
+    double   p99;
+} tResumenFase;
+
+/* Estructura opaca que acumula las duraciones medidas de cada fase. */
+typedef struct sRendimiento tRendimiento;
+
+tRendimiento* rendimiento_crear(void);
+
+/* Marca el comienzo de una fase. */
+void rendimiento_iniciar(tRendimiento *r, tFase fase);
+
+/* Marca el final de una fase y guarda su duración como una muestra. */
+void rendimiento_terminar(tRendimiento *r, tFase fase);
+
+/* Calcula mínimo, promedio y percentiles 95/99 de una fase.
+   Con cero muestras todos los campos quedan en 0. */
+void rendimiento_resumir(tRendimiento *r, tFase fase, tResumenFase *resumen);
+
+/* Suma de las muestras de una fase desde la última limpieza, en ms.
+   Es 0 si la fase no se ejecutó (por ejemplo, una capa que no se redibujó). */
+double rendimiento_total_ms(tRendimiento *r, tFase fase);
+
+/* Descarta las muestras acumuladas de todas las fases. */
+void rendimiento_limpiar(tRendimiento *r);
+
+/* Nombre de la fase para reportes. */
+const char* rendimiento_nombre_fase(tFase fase);
+
+/* Escribe un CSV con una fila por fase. Retorna 0 si OK, -1 si error. */
+int rendimiento_exportar_csv(tRendimiento *r, const char *ruta);
+
+void rendimiento_destruir(tRendimiento *r);
+
+#endif // RENDIMIENTO_H_INCLUDED
@@ -1,19 +1,302 @@
 #include "sonidos.h"
+#include "paquete.h"
+#include "cachedisco.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
-#define MIXER_CANAL_LIBRE -1 // Reproduce en el primer canal libre disponible
-#define BUFFER_AUDIO 1024
-#define MONO 1
+#define MIXER_TODOS_CANALES -1 // Aplica la operacion a todos los canales
+#define MS_PRUEBA_LATENCIA 250 // Duracion de la medicion de cada tamano de buffer
+#define CORTES_TOLERADOS 1
+#define LLAMADAS_DESCARTADAS 2 // Las primeras mezclas despues de abrir el dispositivo llegan irregulares
+#define BITS_TABLA 10
+#define TAM_TABLA (1 << BITS_TABLA) // Muestras por periodo de cada forma de onda
+#define COLA_SINTE 16 // Disparos pendientes entre el hilo principal y el de audio
+#define FIRMA_CACHE_SONIDO "MEMOSND1"
+
+// Identifica un efecto ya convertido al formato del dispositivo dentro de la cache
+typedef struct {
+    tOrigenCache origen;        // Archivo del que se decodifico
+    int32_t frecuencia;         // Formato de salida de Mix_OpenAudio
+    int32_t canales;
+    uint16_t formato;           // SDL_AudioFormat de las muestras
+} tClaveCacheSnd;
+
+// Cabecera de un archivo de la cache, seguida por las muestras PCM.
+// Es un archivo local: se escribe en el orden de bytes del equipo.
+typedef struct {
+    tClaveCacheSnd clave;
+    uint32_t bytes;             // Tamano de las muestras guardadas
+} tCabeceraCacheSnd;
 
 struct sSonido{
     Mix_Chunk *chunk;
+    Mix_Music *musica; // Si no es NULL, SDL_mixer la decodifica de a poco mientras suena
+    int32_t maxVoces;  // Canales que puede ocupar a la vez
+    tPrioridadSnd prioridad;
     uint8_t esTono;
 };
 
-tFormatosSnd sonidos_inicializar(void)
+// Quien ocupa cada canal. Solo se consulta junto con Mix_Playing: al terminar una voz
+// el registro queda viejo pero el canal figura libre.
+typedef struct {
+    const tSonido *sonido;
+    uint32_t inicio; // SDL_GetTicks al empezar, para robar la voz mas vieja
+} tVoz;
+
+static tVoz voces[CANALES_EFECTOS];
+static const tSonido *musicaSonando = NULL; // SDL_mixer reproduce una sola musica a la vez
+
+// Voz del sintetizador. Solo la toca el hilo de audio.
+typedef struct {
+    const int16_t *tabla;   // NULL si la voz esta libre
+    uint32_t fase;          // Posicion en la tabla en punto fijo: los BITS_TABLA altos son el indice
+    double incremento;      // Avance de fase por muestra; el barrido lo cambia de a poco
+    double barrido;         // Cambio del incremento por muestra
+    uint32_t posicion;      // Muestras generadas
+    uint32_t ataque;        // Fin de cada tramo de la envolvente, en muestras desde el inicio
+    uint32_t decaimiento;
+    uint32_t sostenido;
+    uint32_t fin;
+    float nivelSostenido;
+    float volumen;
+} tVozSinte;
+
+static int16_t tablas[ONDAS_SINTE][TAM_TABLA];
+static int tablasListas = 0;
+static tVozSinte vocesSinte[VOCES_SINTE];
+static int frecuenciaSinte = FREC_MUESTREO;
+static int canalesSinte = 1;
+
+// Cola de un productor (hilo principal) y un consumidor (hilo de audio), sin bloqueos
+static tEfectoSinte colaSinte[COLA_SINTE];
+static SDL_atomic_t colaEscritos;
+static SDL_atomic_t colaLeidos;
+
+// Medicion de cortes: las escribe el hilo de audio de SDL
+static SDL_atomic_t llamadasMezcla;
+static SDL_atomic_t llamadasTarde;
+static uint64_t ultimaMezcla;
+static uint64_t periodoMaximo; // En ticks de SDL_GetPerformanceCounter
+
+/* Se llama en el hilo de audio despues de cada mezcla. Si entre dos llamadas pasa mas
+   de un periodo y medio del buffer, el dispositivo se quedo sin muestras: un corte. */
+static void _medir_mezcla(void *contexto, Uint8 *flujo, int bytes)
+{
+    (void)contexto; (void)flujo; (void)bytes;
+    uint64_t ahora = SDL_GetPerformanceCounter();
+    if (SDL_AtomicAdd(&llamadasMezcla, 1) >= LLAMADAS_DESCARTADAS && ahora - ultimaMezcla > periodoMaximo) {
+        SDL_AtomicAdd(&llamadasTarde, 1);
+    }
+    ultimaMezcla = ahora;
+}
+
+// Deja sonar el dispositivo recien abierto y cuenta los cortes. Retorna 1 si no hubo mas de los tolerados.
+static int _buffer_sin_cortes(int32_t muestras)
+{
+    int frecuencia, canales;
+    uint16_t formato;
+    if (!Mix_QuerySpec(&frecuencia, &formato, &canales) || frecuencia <= 0) {
+        return 0;
+    }
+
+    SDL_AtomicSet(&llamadasMezcla, 0);
+    SDL_AtomicSet(&llamadasTarde, 0);
+    ultimaMezcla = 0;
+    periodoMaximo = (SDL_GetPerformanceFrequency() * (uint64_t)muestras * 3) / ((uint64_t)frecuencia * 2);
+
+    Mix_SetPostMix(_medir_mezcla, NULL);
+    SDL_Delay(MS_PRUEBA_LATENCIA);
+    Mix_SetPostMix(NULL, NULL);
+
+    return SDL_AtomicGet(&llamadasMezcla) > LLAMADAS_DESCARTADAS &&
+           SDL_AtomicGet(&llamadasTarde) <= CORTES_TOLERADOS;
+}
+
+/* Abre el dispositivo con el buffer pedido. En baja latencia, si hay cortes o el
+   tamano no se acepta, lo duplica hasta llegar a BUFFER_AUDIO_SEGURO. El buffer que
+   ya paso la medicion en un arranque anterior se acepta sin volver a medirlo. */
+static int _abrir_dispositivo(tAjustesAudio *ajustes)
+{
+    int32_t muestras = BUFFER_AUDIO_SEGURO;
+    if (ajustes->bajaLatencia) {
+        muestras = BUFFER_AUDIO_MINIMO;
+        while (muestras < ajustes->muestrasBuffer && muestras < BUFFER_AUDIO_SEGURO) {
+            muestras *= 2; // SDL pide potencias de dos
+        }
+    }
+
+    for (;;) {
+        int abierto = Mix_OpenAudio(FREC_MUESTREO, MIX_DEFAULT_FORMAT, ajustes->canales, muestras) == 0;
+        if (abierto && (muestras >= BUFFER_AUDIO_SEGURO || muestras == ajustes->muestrasVerificadas ||
+                        _buffer_sin_cortes(muestras))) {
+            ajustes->muestrasBuffer = muestras;
+            ajustes->muestrasVerificadas = muestras;
+            return 1;
+        }
+        if (muestras >= BUFFER_AUDIO_SEGURO) {
+            return 0;
+        }
+
+        if (abierto) {
+            Mix_CloseAudio();
+        }
+        muestras *= 2;
+    }
+}
+
+/* ---- Sintetizador ---- */
+
+// Un periodo de cada forma de onda. Se calcula una sola vez: generar es solo leer la tabla.
+static void _construir_tablas(void)
+{
+    if (tablasListas) {
+        return;
+    }
+
+    uint32_t semilla = 0x12345678u;
+    for (int32_t i = 0; i < TAM_TABLA; i++) {
+        tablas[ONDA_SENO][i] = (int16_t)(AMPLITUD_TONO * sin(2.0 * M_PI * i / TAM_TABLA));
+        tablas[ONDA_CUADRADA][i] = (i < TAM_TABLA / 2) ? AMPLITUD_TONO : -AMPLITUD_TONO;
+        tablas[ONDA_SIERRA][i] = (int16_t)(-AMPLITUD_TONO + (2 * AMPLITUD_TONO * i) / TAM_TABLA);
+
+        semilla ^= semilla << 13; // xorshift32
+        semilla ^= semilla >> 17;
+        semilla ^= semilla << 5;
+        tablas[ONDA_RUIDO][i] = (int16_t)((int32_t)(semilla % (2 * AMPLITUD_TONO + 1)) - AMPLITUD_TONO);
+    }
+    tablasListas = 1;
+}
+
+static uint32_t _ms_a_muestras(uint16_t ms)
+{
+    return (uint32_t)(((uint64_t)ms * frecuenciaSinte) / 1000);
+}
+
+// Pasa un efecto pedido a una voz: la libre, o si no hay, la que lleva mas tiempo sonando
+static void _iniciar_voz(const tEfectoSinte *efecto)
+{
+    tVozSinte *voz = &vocesSinte[0];
+    for (int32_t i = 0; i < VOCES_SINTE && voz->tabla; i++) {
+        if (!vocesSinte[i].tabla || vocesSinte[i].posicion > voz->posicion) {
+            voz = &vocesSinte[i];
+        }
+    }
+
+    uint32_t duracion = _ms_a_muestras(efecto->ataqueMs) + _ms_a_muestras(efecto->decaimientoMs) +
+                        _ms_a_muestras(efecto->sostenidoMs) + _ms_a_muestras(efecto->relajacionMs);
+    double porHz = 4294967296.0 / frecuenciaSinte; // Una vuelta de la tabla es 2^32 de fase
+    float frecuenciaFinal = (efecto->frecuenciaFinal > 0.0f) ? efecto->frecuenciaFinal : efecto->frecuencia;
+
+    voz->tabla = tablas[(efecto->onda < ONDAS_SINTE) ? efecto->onda : ONDA_SENO];
+    voz->fase = 0;
+    voz->incremento = efecto->frecuencia * porHz;
+    voz->barrido = duracion ? (frecuenciaFinal - efecto->frecuencia) * porHz / duracion : 0.0;
+    voz->posicion = 0;
+    voz->ataque = _ms_a_muestras(efecto->ataqueMs);
+    voz->decaimiento = voz->ataque + _ms_a_muestras(efecto->decaimientoMs);
+    voz->sostenido = voz->decaimiento + _ms_a_muestras(efecto->sostenidoMs);
+    voz->fin = duracion;
+    voz->nivelSostenido = efecto->nivelSostenido;
+    voz->volumen = efecto->volumen;
+}
+
+// Envolvente ADSR en la posicion actual, entre 0 y 1
+static float _envolvente(const tVozSinte *voz)
+{
+    uint32_t t = voz->posicion;
+    if (t < voz->ataque) {
+        return (float)t / voz->ataque;
+    }
+    if (t < voz->decaimiento) {
+        return 1.0f - (1.0f - voz->nivelSostenido) * (t - voz->ataque) / (voz->decaimiento - voz->ataque);
+    }
+    if (t < voz->sostenido) {
+        return voz->nivelSostenido;
+    }
+    return voz->nivelSostenido * (voz->fin - t) / (voz->fin - voz->sostenido);
+}
+
+/* Efecto de SDL_mixer sobre la mezcla final: toma los disparos pendientes y suma las
+   voces activas directo en el flujo de salida, sin reservar memoria. */
+static void _generar_sinte(int canal, void *flujo, int bytes, void *contexto)
 {
+    (void)canal; (void)contexto;
+
+    int leidos = SDL_AtomicGet(&colaLeidos);
+    while (leidos != SDL_AtomicGet(&colaEscritos)) {
+        _iniciar_voz(&colaSinte[leidos % COLA_SINTE]);
+        leidos++;
+    }
+    SDL_AtomicSet(&colaLeidos, leidos);
+
+    int16_t *salida = (int16_t*)flujo; // El dispositivo se abre con MIX_DEFAULT_FORMAT: 16 bits
+    int32_t cuadros = bytes / (int32_t)(sizeof(int16_t) * canalesSinte);
+    for (int32_t v = 0; v < VOCES_SINTE; v++) {
+        tVozSinte *voz = &vocesSinte[v];
+        for (int32_t i = 0; voz->tabla && i < cuadros; i++) {
+            if (voz->posicion >= voz->fin) {
+                voz->tabla = NULL;
+                break;
+            }
+
+            int32_t muestra = (int32_t)(voz->tabla[voz->fase >> (32 - BITS_TABLA)] * _envolvente(voz) * voz->volumen);
+            for (int32_t c = 0; c < canalesSinte; c++) {
+                int32_t mezcla = salida[i * canalesSinte + c] + muestra;
+                salida[i * canalesSinte + c] = (int16_t)(mezcla > 32767 ? 32767 : (mezcla < -32768 ? -32768 : mezcla));
+            }
+
+            voz->fase += (uint32_t)voz->incremento;
+            voz->incremento += voz->barrido;
+            voz->posicion++;
+        }
+    }
+}
+
+static void _iniciar_sinte(void)
+{
+    uint16_t formato;
+    if (!Mix_QuerySpec(&frecuenciaSinte, &formato, &canalesSinte)) {
+        frecuenciaSinte = FREC_MUESTREO;
+        canalesSinte = 1;
+    }
+
+    _construir_tablas();
+    memset(vocesSinte, 0, sizeof(vocesSinte));
+    SDL_AtomicSet(&colaEscritos, 0);
+    SDL_AtomicSet(&colaLeidos, 0);
+
+    if (!Mix_RegisterEffect(MIX_CHANNEL_POST, _generar_sinte, NULL, NULL)) {
+        fprintf(stderr, "Aviso: no se pudo iniciar el sintetizador: %s\n", Mix_GetError());
+    }
+}
+
+void sonidos_sintetizar(const tEfectoSinte *efecto)
+{
+    if (!efecto) {
+        return;
+    }
+
+    int escritos = SDL_AtomicGet(&colaEscritos);
+    if (escritos - SDL_AtomicGet(&colaLeidos) >= COLA_SINTE) {
+        return; // El hilo de audio esta atrasado: el efecto se descarta
+    }
+
+    colaSinte[escritos % COLA_SINTE] = *efecto;
+    SDL_AtomicSet(&colaEscritos, escritos + 1); // Publica el efecto recien despues de copiarlo
+}
+
+tFormatosSnd sonidos_inicializar(tAjustesAudio *ajustes)
+{
+    tAjustesAudio porDefecto = { BUFFER_AUDIO_SEGURO, 1, 0, 0 };
+    if (!ajustes) {
+        ajustes = &porDefecto;
+    }
+    if (ajustes->canales != 1 && ajustes->canales != 2) {
+        ajustes->canales = 1;
+    }
+
     tFormatosSnd formatosSnd = SONIDO_WAV; // Soporte para WAV ya incluido
     int32_t flags = MIX_INIT_MP3 | MIX_INIT_OGG;
     int32_t init = Mix_Init(flags); // Inicializa SDL_mixer
@@ -30,17 +313,86 @@ tFormatosSnd sonidos_inicializar(void)
         formatosSnd |= SONIDO_OGG;
     }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, MONO, BUFFER_AUDIO) < 0) { // Abre el dispositivo de audio en modo Mono
+    if (!_abrir_dispositivo(ajustes)) {
         fprintf(stderr, "Error: No se pudo abrir el dispositivo de audio: %s\n", Mix_GetError());
         Mix_Quit();
         return SONIDO_ERR;
     }
 
-    Mix_Volume(-1, 50); // Reducion del volumen al 50% de forma fija a efectos de no molestar a quien inicie esta demo
+    Mix_AllocateChannels(CANALES_EFECTOS); // Presupuesto fijo: el costo de mezcla no crece con las rafagas
+    memset(voces, 0, sizeof(voces));
+    Mix_Volume(MIXER_TODOS_CANALES, 50); // Reducion del volumen al 50% de forma fija a efectos de no molestar a quien inicie esta demo
+    Mix_VolumeMusic(50); // Misma reduccion para la musica en streaming
+    _iniciar_sinte();
 
     return formatosSnd;
 }
 
+
+/* ---- Cache de efectos convertidos ---- */
+
+// Arma la cabecera esperada y el nombre del archivo. Retorna 0 si el sonido no se puede cachear.
+static int _clave_cache(const char *path, tClaveCacheSnd *clave, char *archivo, size_t tamArchivo)
+{
+    int frecuencia, canales;
+    uint16_t formato;
+    if (!Mix_QuerySpec(&frecuencia, &formato, &canales)) {
+        return 0;
+    }
+
+    memset(clave, 0, sizeof(tClaveCacheSnd)); // La clave entera se compara con memcmp
+    if (!cache_disco_origen(&clave->origen, FIRMA_CACHE_SONIDO, path)) {
+        return 0;
+    }
+    clave->frecuencia = frecuencia;
+    clave->canales = canales;
+    clave->formato = formato;
+
+    cache_disco_nombre(clave, sizeof(tClaveCacheSnd), "snd", archivo, tamArchivo);
+    return 1;
+}
+
+static Mix_Chunk* _leer_cache(const char *archivo, const tClaveCacheSnd *clave)
+{
+    SDL_RWops *rw = SDL_RWFromFile(archivo, "rb");
+    if (!rw) {
+        return NULL;
+    }
+
+    tCabeceraCacheSnd cabecera;
+    uint8_t *muestras = NULL;
+    if (SDL_RWread(rw, &cabecera, sizeof(cabecera), 1) == 1 &&
+        memcmp(&cabecera.clave, clave, sizeof(tClaveCacheSnd)) == 0 &&
+        cabecera.bytes > 0) {
+        muestras = SDL_malloc(cabecera.bytes);
+    }
+
+    // Las muestras ya estan en el formato del dispositivo: se leen tal cual, sin decodificar
+    if (muestras && SDL_RWread(rw, muestras, cabecera.bytes, 1) != 1) {
+        SDL_free(muestras);
+        muestras = NULL;
+    }
+    SDL_RWclose(rw);
+
+    Mix_Chunk *chunk = muestras ? Mix_QuickLoad_RAW(muestras, cabecera.bytes) : NULL;
+    if (!chunk) {
+        SDL_free(muestras);
+        return NULL;
+    }
+    chunk->allocated = 1; // Asi Mix_FreeChunk tambien libera las muestras
+
+    return chunk;
+}
+
+static void _escribir_cache(const char *archivo, const tClaveCacheSnd *clave, const Mix_Chunk *chunk)
+{
+    tCabeceraCacheSnd cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    cabecera.clave = *clave;
+    cabecera.bytes = chunk->alen;
+    cache_disco_escribir(archivo, &cabecera, sizeof(cabecera), chunk->abuf, chunk->alen, 1, 0);
+}
+
 tSonido* sonidos_cargar(const char *path)
 {
     tSonido *sonido = malloc(sizeof(tSonido));
@@ -49,13 +401,53 @@ tSonido* sonidos_cargar(const char *path)
     }
 
     sonido->esTono = 0;
-    sonido->chunk = Mix_LoadWAV(path);
+    sonido->musica = NULL;
+    sonido->maxVoces = CANALES_EFECTOS;
+    sonido->prioridad = PRIORIDAD_NORMAL;
+
+    tClaveCacheSnd clave;
+    char archivo[FILENAME_MAX];
+    int cacheable = _clave_cache(path, &clave, archivo, sizeof(archivo));
+    sonido->chunk = cacheable ? _leer_cache(archivo, &clave) : NULL;
+    if (sonido->chunk) {
+        return sonido;
+    }
+
+    // SDL_mixer decodifica y convierte al formato del dispositivo; el resultado se guarda para la proxima
+    SDL_RWops *rw = paquete_leer(path); // Si hay paquete de recursos se lee de la memoria mapeada
+    sonido->chunk = rw ? Mix_LoadWAV_RW(rw, 1) : Mix_LoadWAV(path);
     if (!sonido->chunk) {
         fprintf(stderr, "Fallo la carga del sonido \"%s:\" %s\n", path, Mix_GetError());
         free(sonido);
         return NULL;
     }
 
+    if (cacheable) {
+        _escribir_cache(archivo, &clave, sonido->chunk);
+    }
+
+    return sonido;
+}
+
+tSonido* sonidos_cargar_musica(const char *path)
+{
+    tSonido *sonido = malloc(sizeof(tSonido));
+    if (!sonido) {
+        return NULL;
+    }
+
+    sonido->esTono = 0;
+    sonido->chunk = NULL;
+    sonido->maxVoces = 1;
+    sonido->prioridad = PRIORIDAD_NORMAL;
+    SDL_RWops *rw = paquete_leer(path); // El mapeo del paquete sigue vivo mientras la musica suena
+    sonido->musica = rw ? Mix_LoadMUS_RW(rw, 1) : Mix_LoadMUS(path);
+    if (!sonido->musica) {
+        fprintf(stderr, "Fallo la carga de la musica \"%s:\" %s\n", path, Mix_GetError());
+        free(sonido);
+        return NULL;
+    }
+
     return sonido;
 }
 
@@ -66,15 +458,28 @@ tSonido* sonidos_crear_tono(float frecuencia)
         return NULL;
     }
 
-    int16_t *buffer = malloc(sizeof(int16_t) * FREC_MUESTREO);
+    // El buffer va directo al mezclador: una muestra por canal del dispositivo
+    int frecuenciaDisp, canales;
+    uint16_t formatoDisp;
+    if (!Mix_QuerySpec(&frecuenciaDisp, &formatoDisp, &canales)) {
+        canales = 1;
+    }
+
+    int16_t *buffer = malloc(sizeof(int16_t) * FREC_MUESTREO * canales);
     if (!buffer) {
         free(sonido);
         fprintf(stderr, "No se pudo reservar memoria para el tono\n");
         return NULL;
     }
 
-    for (int32_t i = 0; i < FREC_MUESTREO; i++) {
-        buffer[i] = AMPLITUD_TONO * sin(2.0 * M_PI * frecuencia * i / FREC_MUESTREO); // Amplitud * seno(2Pi * frecuencia * dTiempo)
+    // Se recorre la tabla de seno en lugar de calcular sin() en cada muestra
+    _construir_tablas();
+    uint32_t fase = 0, incremento = (uint32_t)(frecuencia * 4294967296.0 / FREC_MUESTREO);
+    for (int32_t i = 0; i < FREC_MUESTREO; i++, fase += incremento) {
+        int16_t muestra = tablas[ONDA_SENO][fase >> (32 - BITS_TABLA)];
+        for (int32_t c = 0; c < canales; c++) {
+            buffer[i * canales + c] = muestra;
+        }
     }
 
     sonido->chunk = malloc(sizeof(Mix_Chunk));
@@ -85,16 +490,86 @@ tSonido* sonidos_crear_tono(float frecuencia)
         return NULL;
     }
 
-    sonido->chunk->alen = FREC_MUESTREO * sizeof(int16_t); // Cantidad de bytes del buffer de audio
+    sonido->chunk->alen = FREC_MUESTREO * canales * sizeof(int16_t); // Cantidad de bytes del buffer de audio
     sonido->chunk->abuf = (uint8_t*)buffer;
     sonido->chunk->volume = MIX_MAX_VOLUME;
+    sonido->musica = NULL;
+    sonido->maxVoces = CANALES_EFECTOS;
+    sonido->prioridad = PRIORIDAD_NORMAL;
     sonido->esTono = 1;
 
     return sonido;
 }
 
+void sonidos_configurar_voces(tSonido *sonido, int32_t maxVoces, tPrioridadSnd prioridad)
+{
+    if (!sonido) {
+        return;
+    }
+
+    sonido->maxVoces = (maxVoces < 1) ? 1 : (maxVoces > CANALES_EFECTOS ? CANALES_EFECTOS : maxVoces);
+    sonido->prioridad = prioridad;
+}
+
+// Un canal sin registro (liberado su sonido mientras sonaba) cuenta como prioridad normal
+static tPrioridadSnd _prioridad_voz(int32_t canal)
+{
+    return voces[canal].sonido ? voces[canal].sonido->prioridad : PRIORIDAD_NORMAL;
+}
+
+/* Elige el canal para una nueva voz del sonido:
+   1. Si ya tiene maxVoces sonando, reemplaza la mas vieja de ellas.
+   2. Si no, un canal libre.
+   3. Si no hay, roba la voz de menor prioridad (la mas vieja ante empates) que no
+      supere la del sonido. Retorna -1 si todas las voces son mas importantes. */
+static int32_t _elegir_canal(const tSonido *sonido)
+{
+    int32_t propias = 0, propiaVieja = -1, libre = -1, victima = -1;
+
+    for (int32_t canal = 0; canal < CANALES_EFECTOS; canal++) {
+        if (!Mix_Playing(canal)) {
+            if (libre < 0) {
+                libre = canal;
+            }
+            continue;
+        }
+
+        const tVoz *voz = &voces[canal];
+        if (voz->sonido == sonido) {
+            propias++;
+            if (propiaVieja < 0 || voz->inicio < voces[propiaVieja].inicio) {
+                propiaVieja = canal;
+            }
+        }
+
+        tPrioridadSnd prioridad = _prioridad_voz(canal);
+        if (prioridad <= sonido->prioridad &&
+            (victima < 0 || prioridad < _prioridad_voz(victima) ||
+             (prioridad == _prioridad_voz(victima) && voz->inicio < voces[victima].inicio))) {
+            victima = canal;
+        }
+    }
+
+    if (propias >= sonido->maxVoces) {
+        return propiaVieja;
+    }
+
+    return (libre >= 0) ? libre : victima;
+}
+
 void sonidos_reproducir(const tSonido *sonido, int32_t cantVeces)
 {
+    if (sonido->musica) {
+        // A diferencia de Mix_PlayChannel, Mix_PlayMusic recibe la cantidad de reproducciones
+        int32_t veces = (cantVeces == -1) ? -1 : ((cantVeces > 0) ? cantVeces : 1);
+        if (Mix_PlayMusic(sonido->musica, veces) == -1) {
+            fprintf(stderr, "No se pudo reproducir la musica: %s\n", Mix_GetError());
+            return;
+        }
+        musicaSonando = sonido;
+        return;
+    }
+
     if (!sonido->chunk) {
         return;
     }
@@ -106,8 +581,37 @@ void sonidos_reproducir(const tSonido *sonido, int32_t cantVeces)
         loops = (cantVeces > 0) ? (cantVeces - 1) : 0; // En mixer 0 para una vez, 1 para dos, etc.. y no acepta valores menores a -1
     }
 
-    if (Mix_PlayChannel(MIXER_CANAL_LIBRE, sonido->chunk, loops) == -1) {
+    int32_t canal = _elegir_canal(sonido);
+    if (canal < 0) {
+        return; // Todas las voces son mas importantes: el efecto se descarta
+    }
+
+    if (Mix_PlayChannel(canal, sonido->chunk, loops) == -1) { // Si el canal sonaba, lo reemplaza
         fprintf(stderr, "No se pudo reproducir el sonido: %s\n", Mix_GetError());
+        return;
+    }
+    voces[canal].sonido = sonido;
+    voces[canal].inicio = SDL_GetTicks();
+}
+
+void sonidos_detener(const tSonido *sonido)
+{
+    if (sonido && sonido->musica) {
+        if (musicaSonando == sonido) {
+            Mix_HaltMusic();
+            musicaSonando = NULL;
+        }
+        return;
+    }
+
+    if (!sonido || !sonido->chunk) {
+        return;
+    }
+
+    for (int32_t canal = 0; canal < CANALES_EFECTOS; canal++) {
+        if (Mix_Playing(canal) && Mix_GetChunk(canal) == sonido->chunk) {
+            Mix_HaltChannel(canal);
+        }
     }
 }
 
@@ -117,7 +621,18 @@ void sonidos_destruir(tSonido *sonido)
         return;
     }
 
-    if (sonido->esTono) {
+    for (int32_t canal = 0; canal < CANALES_EFECTOS; canal++) {
+        if (voces[canal].sonido == sonido) {
+            voces[canal].sonido = NULL; // Una instancia nueva podria ocupar la misma direccion
+        }
+    }
+
+    if (sonido->musica) {
+        Mix_FreeMusic(sonido->musica); // Si estaba sonando, la detiene antes de liberarla
+        if (musicaSonando == sonido) {
+            musicaSonando = NULL;
+        }
+    } else if (sonido->esTono) {
         if (sonido->chunk) {
             if (sonido->chunk->abuf) {
                 free(sonido->chunk->abuf);
@@ -135,7 +650,10 @@ void sonidos_destruir(tSonido *sonido)
 
 void sonidos_finalizar(void)
 {
-    Mix_HaltChannel(-1);
+    Mix_HaltChannel(MIXER_TODOS_CANALES);
+    Mix_UnregisterAllEffects(MIX_CHANNEL_POST);
+    Mix_HaltMusic();
+    musicaSonando = NULL;
     Mix_CloseAudio();
     Mix_Quit();
 }
@@ -5,6 +5,10 @@
 
 #define AMPLITUD_TONO 8192
 #define FREC_MUESTREO 44100
+#define CANALES_EFECTOS 8 // Voces simultaneas como maximo entre todos los efectos
+#define VOCES_SINTE 8     // Efectos sintetizados simultaneos, aparte de los canales
+#define BUFFER_AUDIO_SEGURO 1024 // Muestras por buffer del dispositivo, ~23 ms a 44,1 kHz
+#define BUFFER_AUDIO_MINIMO 128
 
 /**
  * @brief Formatos de audio soportados.
@@ -16,23 +20,79 @@ typedef enum {
     SONIDO_OGG = 0x02,
 } tFormatosSnd;
 
+/**
+ * @brief Prioridad de un efecto al competir por los canales.
+ */
+typedef enum {
+    PRIORIDAD_BAJA,
+    PRIORIDAD_NORMAL,
+    PRIORIDAD_ALTA,
+} tPrioridadSnd;
+
+/**
+ * @brief Formas de onda del sintetizador.
+ */
+typedef enum {
+    ONDA_SENO,
+    ONDA_CUADRADA,
+    ONDA_SIERRA,
+    ONDA_RUIDO,
+    ONDAS_SINTE
+} tOnda;
+
+/**
+ * @brief Efecto sintetizado: una forma de onda con envolvente ADSR y barrido de tono.
+ */
+typedef struct {
+    tOnda onda;
+    float frecuencia;       // Hz al empezar
+    float frecuenciaFinal;  // Hz al terminar (barrido lineal), o 0 para tono fijo
+    uint16_t ataqueMs;
+    uint16_t decaimientoMs;
+    uint16_t sostenidoMs;   // Tiempo en el nivel de sostenido
+    uint16_t relajacionMs;
+    float nivelSostenido;   // 0 a 1, relativo al pico del ataque
+    float volumen;          // 0 a 1
+} tEfectoSinte;
+
+/**
+ * @brief Ajustes del dispositivo de audio.
+ */
+typedef struct {
+    int32_t muestrasBuffer; // Buffer pedido; al abrir queda el que se uso
+    int32_t canales;        // 1 mono, 2 estereo
+    int32_t muestrasVerificadas; // Buffer que ya paso la medicion antes; 0 si ninguno
+    uint8_t bajaLatencia;   // Si es 0 se usa BUFFER_AUDIO_SEGURO
+} tAjustesAudio;
+
 /**
  * @brief Estructura opaca para la gestion de recursos de audio.
  * * * Al ser opaca, oculta si el recurso es un Mix_Chunk cargado
- * desde el disco o un buffer de audio generado.
+ * desde el disco, un buffer de audio generado o una musica en streaming.
  */
 typedef struct sSonido tSonido;
 
 /**
  * @brief Inicializa los subsistemas de audio y abre el dispositivo de salida.
+ * * * En baja latencia abre con el buffer pedido y mide durante un instante si el
+ * mezclador llega a tiempo; si hay cortes, duplica el buffer y vuelve a medir
+ * hasta BUFFER_AUDIO_SEGURO. Bloquea mientras mide: conviene llamarla en un hilo.
+ * Si el buffer pedido es 'muestrasVerificadas', ya paso la medicion y no se repite.
+ *
+ * @param ajustes Ajustes pedidos, o NULL para mono con el buffer seguro. Al volver,
+ * 'muestrasBuffer' tiene el tamano con el que quedo abierto el dispositivo y
+ * 'muestrasVerificadas' el mismo valor, para guardarlo junto con la configuracion.
  *
  * @return tFormatosSnd Mascara de bits con los formatos cargados o SONIDO_ERR si el
  * dispositivo de audio no pudo abrirse.
  */
-tFormatosSnd sonidos_inicializar(void);
+tFormatosSnd sonidos_inicializar(tAjustesAudio *ajustes);
 
 /**
  * @brief Carga un archivo de audio desde el disco.
+ * * * La primera vez lo decodifica y convierte al formato del dispositivo abierto,
+ * y guarda el resultado en "cache/"; las siguientes lo lee ya convertido. Si
+ * cambia el archivo o el formato del dispositivo, se vuelve a decodificar.
  *
  * @param path Ruta al archivo.
  *
@@ -40,6 +100,18 @@ tFormatosSnd sonidos_inicializar(void);
  */
 tSonido* sonidos_cargar(const char *path);
 
+/**
+ * @brief Abre un archivo de audio largo para reproducirlo en streaming.
+ * * * A diferencia de 'sonidos_cargar', no decodifica el archivo completo: SDL_mixer
+ * lo decodifica en bloques chicos mientras suena, con memoria constante.
+ * Solo una musica suena a la vez; reproducir otra reemplaza a la anterior.
+ *
+ * @param path Ruta al archivo.
+ *
+ * @return tSonido* Puntero a la instancia o NULL si hubo error.
+ */
+tSonido* sonidos_cargar_musica(const char *path);
+
 /**
  * @brief Genera un tono puro de onda sinusoidal dada la frecuencia.
  *
@@ -49,14 +121,48 @@ tSonido* sonidos_cargar(const char *path);
  */
 tSonido* sonidos_crear_tono(float frecuencia);
 
+/**
+ * @brief Limita las voces simultaneas de un sonido y fija su prioridad.
+ * * * Por defecto un efecto puede ocupar todos los canales con prioridad normal.
+ * Como las instancias se comparten por la cache de recursos, la configuracion
+ * vale para todos los que reproduzcan el mismo efecto.
+ *
+ * @param sonido Puntero a la instancia de sonido.
+ * @param maxVoces Canales que puede ocupar a la vez (1..CANALES_EFECTOS).
+ * @param prioridad Prioridad frente a los demas efectos cuando no quedan canales.
+ */
+void sonidos_configurar_voces(tSonido *sonido, int32_t maxVoces, tPrioridadSnd prioridad);
+
+/**
+ * @brief Dispara un efecto sintetizado.
+ * * * Las muestras se generan en el hilo de audio mientras suena, a partir de
+ * tablas de onda precalculadas: no se carga ni reserva nada por efecto. Suenan
+ * hasta VOCES_SINTE a la vez; si no hay lugar, reemplaza al mas viejo.
+ * Debe llamarse siempre desde el mismo hilo.
+ *
+ * @param efecto Parametros del efecto; se copian.
+ */
+void sonidos_sintetizar(const tEfectoSinte *efecto);
+
 /**
  * @brief Reproduce un sonido una cantidad 'n' de veces.
+ * * * Los efectos se reparten CANALES_EFECTOS canales fijos. Si el sonido ya usa
+ * todas sus voces, reemplaza la mas vieja; si no quedan canales, roba el de un
+ * efecto de igual o menor prioridad, o se descarta.
  *
  * @param sonido Puntero constante a la instancia de sonido.
  * @param cantVeces Numero de repeticiones o -1 para bucle infinito.
  */
 void sonidos_reproducir(const tSonido *sonido, int32_t cantVeces);
 
+/**
+ * @brief Detiene todos los canales que estan reproduciendo el sonido, o la
+ * musica si es la que esta sonando.
+ *
+ * @param sonido Puntero constante a la instancia de sonido, o NULL (no hace nada).
+ */
+void sonidos_detener(const tSonido *sonido);
+
 /**
  * @brief Libera la memoria asociada al sonido.
  */
@@ -1,5 +1,35 @@
 #include "texto.h"
+#include "vector.h"
+#include "paquete.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GLIFO_PRIMERO     32   // Primer caracter imprimible (espacio)
+#define GLIFO_ULTIMO      255  // Ultimo caracter de Latin-1 (incluye acentos y enie)
+#define CANT_GLIFOS       (GLIFO_ULTIMO - GLIFO_PRIMERO + 1)
+#define GLIFO_REEMPLAZO   '?'  // Se dibuja en lugar de los caracteres fuera del atlas
+#define ANCHO_ATLAS       1024
+#define SEPARACION_GLIFOS 1    // Evita que el filtrado mezcle glifos vecinos
+
+typedef struct {
+    SDL_Rect origen;  // Region del glifo dentro del atlas
+    int32_t avance;   // Desplazamiento horizontal hasta el siguiente glifo
+} tGlifo;
+
+typedef struct {
+    SDL_Renderer *renderer;
+    TTF_Font *fuente;
+    SDL_Texture *textura;       // NULL si no se pudo construir el atlas
+    int32_t anchoTextura;
+    int32_t altoTextura;
+    int32_t altoLinea;
+    tGlifo glifos[CANT_GLIFOS];
+    tVector *vertices;          // Vector de SDL_Vertex reutilizado entre llamadas
+    tVector *indices;           // Vector de int reutilizado entre llamadas
+} tAtlasTexto;
+
+static tVector *atlasCreados = NULL; // Vector de tAtlasTexto*
 
 
 tError texto_inicializar(void)
@@ -14,7 +44,10 @@ tError texto_inicializar(void)
 
 TTF_Font* texto_cargar_fuente(const char *path, uint32_t tam)
 {
-    TTF_Font *fuente = TTF_OpenFont(path, tam);
+    // Si hay paquete de recursos se lee de la memoria mapeada, que debe seguir
+    // abierta mientras la fuente exista
+    SDL_RWops *rw = paquete_leer(path);
+    TTF_Font *fuente = rw ? TTF_OpenFontRW(rw, 1, tam) : TTF_OpenFont(path, tam);
     if (!fuente) {
         fprintf(stderr, "No se pudo cargar la fuente \"%s:\" %s\n", path, TTF_GetError());
     }
@@ -22,8 +55,28 @@ TTF_Font* texto_cargar_fuente(const char *path, uint32_t tam)
     return fuente;
 }
 
+static void _destruir_atlas(tAtlasTexto *atlas)
+{
+    if (atlas->textura) {
+        SDL_DestroyTexture(atlas->textura);
+    }
+    vector_destroy(atlas->vertices);
+    vector_destroy(atlas->indices);
+    free(atlas);
+}
+
 void texto_destruir_fuente(TTF_Font *fuente)
 {
+    for (size_t i = 0; i < vector_size(atlasCreados); ) {
+        tAtlasTexto *atlas = *(tAtlasTexto**)vector_get(atlasCreados, i);
+        if (atlas->fuente == fuente) {
+            _destruir_atlas(atlas);
+            vector_swap_remove(atlasCreados, i); // El orden no importa
+        } else {
+            i++;
+        }
+    }
+
     TTF_CloseFont(fuente);
 }
 
@@ -49,7 +102,285 @@ SDL_Texture* texto_crear_textura(SDL_Renderer *renderer, TTF_Font *fuente, const
     return textura;
 }
 
+/**
+ * Rasteriza todos los glifos de la fuente en blanco y los empaqueta por filas
+ * en una unica superficie. El color final se aplica al dibujar, mediante el
+ * color de los vertices.
+ */
+static tError _construir_atlas(tAtlasTexto *atlas)
+{
+    SDL_Surface *superficies[CANT_GLIFOS] = {0};
+    SDL_Color blanco = {255, 255, 255, 255};
+    int32_t x = 0, y = 0, altoFila = 0;
+    tError err = TODO_OK;
+
+    for (int32_t i = 0; i < CANT_GLIFOS; i++) {
+        uint32_t codigo = GLIFO_PRIMERO + i;
+        tGlifo *glifo = &atlas->glifos[i];
+
+        if (!TTF_GlyphIsProvided32(atlas->fuente, codigo) ||
+            TTF_GlyphMetrics32(atlas->fuente, codigo, NULL, NULL, NULL, NULL, &glifo->avance) != 0) {
+            glifo->avance = -1; // Sin glifo: se reemplaza al dibujar
+            continue;
+        }
+
+        superficies[i] = TTF_RenderGlyph32_Blended(atlas->fuente, codigo, blanco);
+        if (!superficies[i]) {
+            continue; // Glifos sin pixeles, como el espacio, solo aportan su avance
+        }
+
+        if (x + superficies[i]->w > ANCHO_ATLAS) {
+            x = 0;
+            y += altoFila + SEPARACION_GLIFOS;
+            altoFila = 0;
+        }
+
+        glifo->origen = (SDL_Rect){x, y, superficies[i]->w, superficies[i]->h};
+        x += superficies[i]->w + SEPARACION_GLIFOS;
+        if (superficies[i]->h > altoFila) {
+            altoFila = superficies[i]->h;
+        }
+    }
+
+    atlas->anchoTextura = ANCHO_ATLAS;
+    atlas->altoTextura = y + altoFila;
+
+    SDL_Surface *lienzo = SDL_CreateRGBSurfaceWithFormat(0, atlas->anchoTextura, atlas->altoTextura > 0 ? atlas->altoTextura : 1, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!lienzo) {
+        fprintf(stderr, "No se pudo crear el atlas de glifos: %s\n", SDL_GetError());
+        err = ERR_MEMORIA;
+    } else {
+        SDL_FillRect(lienzo, NULL, SDL_MapRGBA(lienzo->format, 0, 0, 0, 0));
+
+        for (int32_t i = 0; i < CANT_GLIFOS; i++) {
+            if (superficies[i]) {
+                SDL_SetSurfaceBlendMode(superficies[i], SDL_BLENDMODE_NONE); // Copia el alfa tal cual
+                SDL_BlitSurface(superficies[i], NULL, lienzo, &atlas->glifos[i].origen);
+            }
+        }
+
+        atlas->textura = SDL_CreateTextureFromSurface(atlas->renderer, lienzo);
+        SDL_FreeSurface(lienzo);
+
+        if (!atlas->textura) {
+            fprintf(stderr, "No se pudo crear la textura del atlas de glifos: %s\n", SDL_GetError());
+            err = ERR_TEXTURA;
+        } else {
+            SDL_SetTextureBlendMode(atlas->textura, SDL_BLENDMODE_BLEND);
+        }
+    }
+
+    for (int32_t i = 0; i < CANT_GLIFOS; i++) {
+        if (superficies[i]) {
+            SDL_FreeSurface(superficies[i]);
+        }
+    }
+
+    return err;
+}
+
+/**
+ * Devuelve el atlas asociado al par (renderer, fuente), construyendolo la
+ * primera vez que se solicita. Si la construccion falla, el atlas queda
+ * registrado sin textura para no reintentarlo en cada cuadro.
+ */
+static tAtlasTexto* _obtener_atlas(SDL_Renderer *renderer, TTF_Font *fuente)
+{
+    if (!renderer || !fuente) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < vector_size(atlasCreados); i++) {
+        tAtlasTexto *atlas = *(tAtlasTexto**)vector_get(atlasCreados, i);
+        if (atlas->renderer == renderer && atlas->fuente == fuente) {
+            return atlas;
+        }
+    }
+
+    if (!atlasCreados) {
+        atlasCreados = vector_create(sizeof(tAtlasTexto*));
+        if (!atlasCreados) {
+            return NULL;
+        }
+    }
+
+    tAtlasTexto *atlas = calloc(1, sizeof(tAtlasTexto));
+    if (!atlas) {
+        return NULL;
+    }
+
+    atlas->renderer = renderer;
+    atlas->fuente = fuente;
+    atlas->altoLinea = TTF_FontHeight(fuente);
+    atlas->vertices = vector_create(sizeof(SDL_Vertex));
+    atlas->indices = vector_create(sizeof(int));
+
+    if (!atlas->vertices || !atlas->indices || vector_push_back(atlasCreados, &atlas) != 0) {
+        _destruir_atlas(atlas);
+        return NULL;
+    }
+
+    _construir_atlas(atlas);
+
+    return atlas;
+}
+
+/**
+ * Decodifica el siguiente caracter UTF-8 y avanza el puntero. Las secuencias
+ * invalidas se consumen de a un byte y devuelven el caracter de reemplazo.
+ */
+static uint32_t _utf8_siguiente(const char **cursor)
+{
+    const uint8_t *p = (const uint8_t*)*cursor;
+    uint32_t codigo;
+    int32_t extra;
+
+    if (p[0] < 0x80) {
+        codigo = p[0];
+        extra = 0;
+    } else if ((p[0] & 0xE0) == 0xC0) {
+        codigo = p[0] & 0x1F;
+        extra = 1;
+    } else if ((p[0] & 0xF0) == 0xE0) {
+        codigo = p[0] & 0x0F;
+        extra = 2;
+    } else if ((p[0] & 0xF8) == 0xF0) {
+        codigo = p[0] & 0x07;
+        extra = 3;
+    } else {
+        *cursor += 1;
+        return GLIFO_REEMPLAZO;
+    }
+
+    for (int32_t i = 1; i <= extra; i++) {
+        if ((p[i] & 0xC0) != 0x80) {
+            *cursor += i;
+            return GLIFO_REEMPLAZO;
+        }
+        codigo = (codigo << 6) | (p[i] & 0x3F);
+    }
+
+    *cursor += extra + 1;
+    return codigo;
+}
+
+static const tGlifo* _buscar_glifo(const tAtlasTexto *atlas, uint32_t codigo)
+{
+    if (codigo >= GLIFO_PRIMERO && codigo <= GLIFO_ULTIMO &&
+        atlas->glifos[codigo - GLIFO_PRIMERO].avance >= 0) {
+        return &atlas->glifos[codigo - GLIFO_PRIMERO];
+    }
+
+    const tGlifo *reemplazo = &atlas->glifos[GLIFO_REEMPLAZO - GLIFO_PRIMERO];
+    return reemplazo->avance >= 0 ? reemplazo : NULL;
+}
+
+static void _agregar_glifo(tAtlasTexto *atlas, const tGlifo *glifo, float x, float y, SDL_Color color)
+{
+    float u0 = (float)glifo->origen.x / atlas->anchoTextura;
+    float v0 = (float)glifo->origen.y / atlas->altoTextura;
+    float u1 = (float)(glifo->origen.x + glifo->origen.w) / atlas->anchoTextura;
+    float v1 = (float)(glifo->origen.y + glifo->origen.h) / atlas->altoTextura;
+    float w = (float)glifo->origen.w;
+    float h = (float)glifo->origen.h;
+
+    int base = (int)vector_size(atlas->vertices);
+    SDL_Vertex esquinas[4] = {
+        { {x,     y    }, color, {u0, v0} },
+        { {x + w, y    }, color, {u1, v0} },
+        { {x + w, y + h}, color, {u1, v1} },
+        { {x,     y + h}, color, {u0, v1} },
+    };
+    int triangulos[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+
+    vector_push_range(atlas->vertices, esquinas, 4);
+    vector_push_range(atlas->indices, triangulos, 6);
+}
+
+static void _dibujar_sin_atlas(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, int32_t posX, int32_t posY, SDL_Color color)
+{
+    SDL_Texture *textura = texto_crear_textura(renderer, fuente, texto, color);
+    if (textura) {
+        SDL_Rect destino = {posX, posY, 0, 0};
+        SDL_QueryTexture(textura, NULL, NULL, &destino.w, &destino.h);
+        SDL_RenderCopy(renderer, textura, NULL, &destino);
+        SDL_DestroyTexture(textura);
+    }
+}
+
+void texto_dibujar(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, int32_t posX, int32_t posY, SDL_Color color)
+{
+    if (!texto || !texto[0]) {
+        return;
+    }
+
+    tAtlasTexto *atlas = _obtener_atlas(renderer, fuente);
+    if (!atlas || !atlas->textura) {
+        if (renderer && fuente) {
+            _dibujar_sin_atlas(renderer, fuente, texto, posX, posY, color);
+        }
+        return;
+    }
+
+    vector_clear(atlas->vertices);
+    vector_clear(atlas->indices);
+
+    float x = (float)posX;
+    const char *cursor = texto;
+    while (*cursor) {
+        const tGlifo *glifo = _buscar_glifo(atlas, _utf8_siguiente(&cursor));
+        if (!glifo) {
+            continue;
+        }
+        if (glifo->origen.w > 0) {
+            _agregar_glifo(atlas, glifo, x, (float)posY, color);
+        }
+        x += glifo->avance;
+    }
+
+    if (vector_size(atlas->indices) > 0) {
+        SDL_RenderGeometry(renderer, atlas->textura,
+                           (const SDL_Vertex*)atlas->vertices->data, (int)vector_size(atlas->vertices),
+                           (const int*)atlas->indices->data, (int)vector_size(atlas->indices));
+    }
+}
+
+void texto_medir(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, int32_t *ancho, int32_t *alto)
+{
+    int32_t w = 0, h = 0;
+    tAtlasTexto *atlas = _obtener_atlas(renderer, fuente);
+
+    if (atlas && atlas->textura && texto) {
+        const char *cursor = texto;
+        while (*cursor) {
+            const tGlifo *glifo = _buscar_glifo(atlas, _utf8_siguiente(&cursor));
+            if (glifo) {
+                w += glifo->avance;
+            }
+        }
+        h = atlas->altoLinea;
+    } else if (fuente && texto) {
+        TTF_SizeUTF8(fuente, texto, &w, &h);
+    }
+
+    if (ancho) *ancho = w;
+    if (alto)  *alto = h;
+}
+
+void texto_dibujar_centrado(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, const SDL_Rect *rect, SDL_Color color)
+{
+    int32_t w, h;
+    texto_medir(renderer, fuente, texto, &w, &h);
+    texto_dibujar(renderer, fuente, texto, rect->x + (rect->w - w) / 2, rect->y + (rect->h - h) / 2, color);
+}
+
 void texto_finalizar(void)
 {
+    for (size_t i = 0; i < vector_size(atlasCreados); i++) {
+        _destruir_atlas(*(tAtlasTexto**)vector_get(atlasCreados, i));
+    }
+    vector_destroy(atlasCreados);
+    atlasCreados = NULL;
+
     TTF_Quit();
 }
@@ -22,6 +22,7 @@ TTF_Font* texto_cargar_fuente(const char *path, uint32_t tam);
 
 /**
  * @brief Libera la memoria asociada a la fuente.
+ * * * Si la fuente tenia un atlas de glifos asociado, tambien se destruye.
  * @param fuente Puntero a la fuente a destruir.
  */
 void texto_destruir_fuente(TTF_Font *fuente);
@@ -40,8 +41,47 @@ void texto_destruir_fuente(TTF_Font *fuente);
  */
 SDL_Texture* texto_crear_textura(SDL_Renderer *renderer, TTF_Font *fuente, const char* texto, SDL_Color color);
 
+/**
+ * @brief Dibuja una cadena de texto utilizando el atlas de glifos de la fuente.
+ * * * La primera vez que se utiliza una fuente con un renderizador se rasterizan
+ * todos sus glifos en una unica textura compartida (atlas). A partir de ahi, cada
+ * cadena se dibuja como un lote de cuadrilateros en una sola llamada, sin crear
+ * ni destruir texturas por cuadro.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param fuente Puntero a una fuente TTF.
+ * @param texto Cadena UTF-8 a dibujar.
+ * @param posX Coordenada X de la esquina superior izquierda.
+ * @param posY Coordenada Y de la esquina superior izquierda.
+ * @param color Estructura 'SDL_Color' con el color del texto.
+ */
+void texto_dibujar(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, int32_t posX, int32_t posY, SDL_Color color);
+
+/**
+ * @brief Dibuja una cadena de texto centrada dentro de un rectangulo.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param fuente Puntero a una fuente TTF.
+ * @param texto Cadena UTF-8 a dibujar.
+ * @param rect Puntero constante al rectangulo contenedor.
+ * @param color Estructura 'SDL_Color' con el color del texto.
+ */
+void texto_dibujar_centrado(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, const SDL_Rect *rect, SDL_Color color);
+
+/**
+ * @brief Calcula el tamano que ocupara una cadena dibujada con 'texto_dibujar'.
+ *
+ * @param renderer Puntero al renderizador de SDL.
+ * @param fuente Puntero a una fuente TTF.
+ * @param texto Cadena UTF-8 a medir.
+ * @param ancho Puntero donde se guarda el ancho en pixeles, o NULL.
+ * @param alto Puntero donde se guarda el alto en pixeles, o NULL.
+ */
+void texto_medir(SDL_Renderer *renderer, TTF_Font *fuente, const char *texto, int32_t *ancho, int32_t *alto);
+
 /**
  * @brief Libera los recursos de SDL_ttf.
+ * * * Tambien destruye todos los atlas de glifos que sigan en uso.
  */
 void texto_finalizar(void);
 
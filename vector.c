@@ -3,18 +3,41 @@
 #include <string.h>
 
 #define VECTOR_INITIAL_CAP 8
+#define VECTOR_GROWTH 2.0f
+
+static void* _heap_resize(void *ctx, void *ptr, size_t oldSize, size_t newSize)
+{
+    (void)ctx; (void)oldSize;
+    return realloc(ptr, newSize);
+}
+
+static void _heap_release(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+static const tAllocator HEAP_ALLOCATOR = { _heap_resize, _heap_release, NULL };
 
 tVector* vector_create(size_t elemSize)
+{
+    return vector_create_with(elemSize, NULL);
+}
+
+tVector* vector_create_with(size_t elemSize, const tAllocator *allocator)
 {
     if (elemSize == 0) return NULL;
-    tVector *v = (tVector*)malloc(sizeof(tVector));
+    if (!allocator) allocator = &HEAP_ALLOCATOR;
+    tVector *v = (tVector*)allocator->resize(allocator->ctx, NULL, 0, sizeof(tVector));
     if (!v) return NULL;
+    v->allocator = *allocator;
     v->elemSize = elemSize;
     v->size = 0;
     v->capacity = VECTOR_INITIAL_CAP;
-    v->data = malloc(v->capacity * v->elemSize);
+    v->growth = VECTOR_GROWTH;
+    v->data = allocator->resize(allocator->ctx, NULL, 0, v->capacity * v->elemSize);
     if (!v->data) {
-        free(v);
+        allocator->release(allocator->ctx, v);
         return NULL;
     }
     return v;
@@ -23,32 +46,47 @@ tVector* vector_create(size_t elemSize)
 void vector_destroy(tVector *v)
 {
     if (!v) return;
-    free(v->data);
-    free(v);
+    tAllocator allocator = v->allocator;
+    allocator.release(allocator.ctx, v->data);
+    allocator.release(allocator.ctx, v);
 }
 
 int vector_reserve(tVector *v, size_t newCapacity)
 {
     if (!v) return -1;
     if (newCapacity <= v->capacity) return 0;
-    void *p = realloc(v->data, newCapacity * v->elemSize);
+    void *p = v->allocator.resize(v->allocator.ctx, v->data,
+                                  v->capacity * v->elemSize, newCapacity * v->elemSize);
     if (!p) return -1;
     v->data = p;
     v->capacity = newCapacity;
     return 0;
 }
 
-static int _ensure_capacity(tVector *v)
+/* Garantiza lugar para 'extra' elementos más, creciendo según el factor. */
+static int _ensure_capacity(tVector *v, size_t extra)
 {
-    if (v->size < v->capacity) return 0;
-    size_t nueva = v->capacity ? v->capacity * 2 : VECTOR_INITIAL_CAP;
+    size_t necesaria = v->size + extra;
+    if (necesaria <= v->capacity) return 0;
+    size_t nueva = v->capacity ? v->capacity : VECTOR_INITIAL_CAP;
+    while (nueva < necesaria) {
+        size_t siguiente = (size_t)(nueva * v->growth);
+        nueva = (siguiente > nueva) ? siguiente : nueva + 1;
+    }
     return vector_reserve(v, nueva);
 }
 
+int vector_set_growth(tVector *v, float factor)
+{
+    if (!v || !(factor > 1.0f)) return -1;
+    v->growth = factor;
+    return 0;
+}
+
 int vector_push_back(tVector *v, const void *elem)
 {
     if (!v || !elem) return -1;
-    if (_ensure_capacity(v) != 0) return -1;
+    if (_ensure_capacity(v, 1) != 0) return -1;
     void *dst = (char*)v->data + (v->size * v->elemSize);
     memcpy(dst, elem, v->elemSize);
     v->size++;
@@ -97,6 +135,70 @@ int vector_remove_at(tVector *v, size_t index)
     return 0;
 }
 
+int vector_push_range(tVector *v, const void *elems, size_t count)
+{
+    if (!v) return -1;
+    return vector_insert_range(v, v->size, elems, count);
+}
+
+int vector_insert_range(tVector *v, size_t index, const void *elems, size_t count)
+{
+    if (!v || (!elems && count > 0)) return -1;
+    if (index > v->size) return -1;
+    if (count == 0) return 0;
+    if (_ensure_capacity(v, count) != 0) return -1;
+    char *pos = (char*)v->data + (index * v->elemSize);
+    if (index < v->size) {
+        memmove(pos + (count * v->elemSize), pos, (v->size - index) * v->elemSize);
+    }
+    memcpy(pos, elems, count * v->elemSize);
+    v->size += count;
+    return 0;
+}
+
+int vector_resize(tVector *v, size_t newSize)
+{
+    if (!v) return -1;
+    if (newSize > v->size) {
+        if (vector_reserve(v, newSize) != 0) return -1;
+        memset((char*)v->data + (v->size * v->elemSize), 0, (newSize - v->size) * v->elemSize);
+    }
+    v->size = newSize;
+    return 0;
+}
+
+void vector_truncate(tVector *v, size_t newSize)
+{
+    if (!v) return;
+    if (newSize < v->size) v->size = newSize;
+}
+
+int vector_shrink_to_fit(tVector *v)
+{
+    if (!v) return -1;
+    size_t nueva = v->size ? v->size : 1;   /* realloc a 0 bytes no es portable */
+    if (nueva >= v->capacity) return 0;
+    void *p = v->allocator.resize(v->allocator.ctx, v->data,
+                                  v->capacity * v->elemSize, nueva * v->elemSize);
+    if (!p) return -1;
+    v->data = p;
+    v->capacity = nueva;
+    return 0;
+}
+
+int vector_swap_remove(tVector *v, size_t index)
+{
+    if (!v) return -1;
+    if (index >= v->size) return -1;
+    if (index + 1 < v->size) {
+        void *dst = (char*)v->data + (index * v->elemSize);
+        void *src = (char*)v->data + ((v->size - 1) * v->elemSize);
+        memcpy(dst, src, v->elemSize);
+    }
+    v->size--;
+    return 0;
+}
+
 void vector_clear(tVector *v)
 {
     if (!v) return;
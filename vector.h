@@ -3,16 +3,29 @@
 
 #include <stddef.h>
 
+/* De dónde saca memoria un vector. 'resize' funciona como realloc (ptr NULL
+   reserva) y recibe además el tamaño anterior; 'release' puede no hacer nada. */
+typedef struct {
+    void* (*resize)(void *ctx, void *ptr, size_t oldSize, size_t newSize);
+    void  (*release)(void *ctx, void *ptr);
+    void *ctx;
+} tAllocator;
+
 typedef struct {
     void *data;
     size_t elemSize;
     size_t size;
     size_t capacity;
+    float growth;       /* factor de crecimiento al llenarse (> 1) */
+    tAllocator allocator;
 } tVector;
 
 
 tVector* vector_create(size_t elemSize);
 
+/* Como vector_create, pero el vector y sus datos salen de 'allocator' (NULL: el heap). */
+tVector* vector_create_with(size_t elemSize, const tAllocator *allocator);
+
 void vector_destroy(tVector *v);
 
 int vector_push_back(tVector *v, const void *elem);
@@ -31,4 +44,25 @@ void vector_clear(tVector *v);
 
 int vector_reserve(tVector *v, size_t newCapacity);
 
+/* Cambia el factor de crecimiento (por defecto 2). Retorna -1 si no es mayor que 1. */
+int vector_set_growth(tVector *v, float factor);
+
+/* Agrega 'count' elementos contiguos al final con una sola copia. */
+int vector_push_range(tVector *v, const void *elems, size_t count);
+
+/* Inserta 'count' elementos contiguos antes de 'index' (index == size agrega al final). */
+int vector_insert_range(tVector *v, size_t index, const void *elems, size_t count);
+
+/* Cambia la cantidad de elementos; los nuevos quedan en cero. */
+int vector_resize(tVector *v, size_t newSize);
+
+/* Descarta los elementos desde 'newSize' en adelante, sin liberar memoria. */
+void vector_truncate(tVector *v, size_t newSize);
+
+/* Ajusta la capacidad a la cantidad de elementos. */
+int vector_shrink_to_fit(tVector *v);
+
+/* Quita el elemento en O(1) moviendo el último a su lugar: no conserva el orden. */
+int vector_swap_remove(tVector *v, size_t index);
+
 #endif // VECTOR_H_INCLUDED